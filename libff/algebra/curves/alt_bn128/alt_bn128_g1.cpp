@@ -6,6 +6,8 @@
  *****************************************************************************/
 
 #include <libff/algebra/curves/alt_bn128/alt_bn128_g1.hpp>
+#include <libff/algebra/curves/hash_to_curve.hpp>
+#include <libff/algebra/fields/hash_to_field.hpp>
 
 namespace libff {
 
@@ -388,17 +390,64 @@ bool alt_bn128_G1::is_well_formed() const
 
 alt_bn128_G1 alt_bn128_G1::zero()
 {
+    init_alt_bn128_params();
     return G1_zero;
 }
 
 alt_bn128_G1 alt_bn128_G1::one()
 {
+    init_alt_bn128_params();
     return G1_one;
 }
 
 alt_bn128_G1 alt_bn128_G1::random_element()
 {
-    return (scalar_field::random_element().as_bigint()) * G1_one;
+    init_alt_bn128_params();
+    return generator_mul<alt_bn128_G1>(scalar_field::random_element().as_bigint());
+}
+
+static const svdw_params<alt_bn128_Fq>& alt_bn128_G1_svdw_params()
+{
+    static const svdw_params<alt_bn128_Fq> params(alt_bn128_Fq::zero(), alt_bn128_coeff_b);
+    return params;
+}
+
+alt_bn128_G1 alt_bn128_G1::map_to_curve(const alt_bn128_Fq &u)
+{
+    alt_bn128_Fq x, y;
+    svdw_map_to_curve(alt_bn128_G1_svdw_params(), u, x, y);
+    return alt_bn128_G1(x, y, alt_bn128_Fq::one());
+}
+
+alt_bn128_G1 alt_bn128_G1::hash_to_curve(const std::string &msg, const std::string &dst)
+{
+    const std::vector<alt_bn128_Fq> u = hash_to_field<alt_bn128_Fq>(msg, dst, 2);
+    /* the cofactor of G1 is 1, so clear_cofactor is the identity */
+    return map_to_curve(u[0]) + map_to_curve(u[1]);
+}
+
+std::vector<alt_bn128_G1> alt_bn128_G1::batch_hash_to_curve(const std::vector<std::string> &msgs, const std::string &dst)
+{
+    std::vector<alt_bn128_Fq> u;
+    u.reserve(2 * msgs.size());
+    for (const std::string &msg : msgs)
+    {
+        const std::vector<alt_bn128_Fq> u_msg = hash_to_field<alt_bn128_Fq>(msg, dst, 2);
+        u.insert(u.end(), u_msg.begin(), u_msg.end());
+    }
+
+    std::vector<alt_bn128_Fq> x, y;
+    batch_svdw_map_to_curve(alt_bn128_G1_svdw_params(), u, x, y);
+
+    std::vector<alt_bn128_G1> result;
+    result.reserve(msgs.size());
+    for (size_t i = 0; i < msgs.size(); ++i)
+    {
+        result.emplace_back(alt_bn128_G1(x[2*i], y[2*i], alt_bn128_Fq::one()) +
+                            alt_bn128_G1(x[2*i+1], y[2*i+1], alt_bn128_Fq::one()));
+    }
+
+    return result;
 }
 
 std::ostream& operator<<(std::ostream &out, const alt_bn128_G1 &g)
@@ -419,6 +468,7 @@ std::ostream& operator<<(std::ostream &out, const alt_bn128_G1 &g)
 
 std::istream& operator>>(std::istream &in, alt_bn128_G1 &g)
 {
+    init_alt_bn128_params();
     char is_zero;
     alt_bn128_Fq tX, tY;
 
@@ -496,7 +546,7 @@ std::istream& operator>>(std::istream& in, std::vector<alt_bn128_G1> &v)
     return in;
 }
 
-void alt_bn128_G1::batch_to_special_all_non_zeros(std::vector<alt_bn128_G1> &vec)
+void alt_bn128_G1::batch_to_special(std::vector<alt_bn128_G1> &vec)
 {
     std::vector<alt_bn128_Fq> Z_vec;
     Z_vec.reserve(vec.size());
@@ -505,12 +555,20 @@ void alt_bn128_G1::batch_to_special_all_non_zeros(std::vector<alt_bn128_G1> &vec
     {
         Z_vec.emplace_back(el.Z);
     }
-    batch_invert<alt_bn128_Fq>(Z_vec);
+    batch_invert_nonzeros<alt_bn128_Fq>(Z_vec);
 
     const alt_bn128_Fq one = alt_bn128_Fq::one();
 
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
     for (size_t i = 0; i < vec.size(); ++i)
     {
+        if (Z_vec[i].is_zero())
+        {
+            continue;
+        }
+
         alt_bn128_Fq Z2 = Z_vec[i].squared();
         alt_bn128_Fq Z3 = Z_vec[i] * Z2;
 
@@ -520,4 +578,41 @@ void alt_bn128_G1::batch_to_special_all_non_zeros(std::vector<alt_bn128_G1> &vec
     }
 }
 
+void alt_bn128_G1::batch_to_special_all_non_zeros(std::vector<alt_bn128_G1> &vec)
+{
+    batch_to_special(vec);
+}
+
+std::vector<alt_bn128_G1> alt_bn128_G1::batch_affine_add(const std::vector<alt_bn128_G1> &a, const std::vector<alt_bn128_G1> &b)
+{
+    ASSERT(a.size() == b.size());
+    const size_t n = a.size();
+
+    std::vector<alt_bn128_Fq> x1, y1, x2, y2;
+    std::vector<bool> is_zero1(n), is_zero2(n);
+    x1.reserve(n); y1.reserve(n); x2.reserve(n); y2.reserve(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        ASSERT(a[i].is_special() && b[i].is_special());
+        x1.emplace_back(a[i].X);
+        y1.emplace_back(a[i].Y);
+        x2.emplace_back(b[i].X);
+        y2.emplace_back(b[i].Y);
+        is_zero1[i] = a[i].is_zero();
+        is_zero2[i] = b[i].is_zero();
+    }
+
+    std::vector<bool> result_is_zero;
+    batch_affine_add_weierstrass<alt_bn128_Fq>(alt_bn128_Fq::zero(), x1, y1, is_zero1, x2, y2, is_zero2, result_is_zero);
+
+    std::vector<alt_bn128_G1> result;
+    result.reserve(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        result.emplace_back(result_is_zero[i] ? alt_bn128_G1::zero() : alt_bn128_G1(x1[i], y1[i], alt_bn128_Fq::one()));
+    }
+
+    return result;
+}
+
 } // libff
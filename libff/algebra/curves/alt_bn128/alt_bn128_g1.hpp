@@ -7,6 +7,7 @@
 
 #ifndef ALT_BN128_G1_HPP_
 #define ALT_BN128_G1_HPP_
+#include <string>
 #include <vector>
 
 #include <libff/algebra/curves/alt_bn128/alt_bn128_init.hpp>
@@ -64,6 +65,17 @@ public:
     static alt_bn128_G1 one();
     static alt_bn128_G1 random_element();
 
+    /**
+     * hash_to_curve: two elements of Fq from hash_to_field (expand_message_xmd
+     * with SHA-256), each mapped with the SVDW map and added. This follows the
+     * structure of RFC 9380, which defines no suite for this curve, and the
+     * encoding is specific to libff; interoperability with other BN254
+     * hash-to-curve implementations is not tested.
+     */
+    static alt_bn128_G1 map_to_curve(const alt_bn128_Fq &u);
+    static alt_bn128_G1 hash_to_curve(const std::string &msg, const std::string &dst);
+    static std::vector<alt_bn128_G1> batch_hash_to_curve(const std::vector<std::string> &msgs, const std::string &dst);
+
     static size_t size_in_bits() { return base_field::size_in_bits() + 1; }
     static bigint<base_field::num_limbs> base_field_char() { return base_field::field_char(); }
     static bigint<scalar_field::num_limbs> order() { return scalar_field::field_char(); }
@@ -71,7 +83,10 @@ public:
     friend std::ostream& operator<<(std::ostream &out, const alt_bn128_G1 &g);
     friend std::istream& operator>>(std::istream &in, alt_bn128_G1 &g);
 
+    static void batch_to_special(std::vector<alt_bn128_G1> &vec); // in place, zeros are left as they are
     static void batch_to_special_all_non_zeros(std::vector<alt_bn128_G1> &vec);
+    // pairwise sums of two vectors of points in special form, in special form
+    static std::vector<alt_bn128_G1> batch_affine_add(const std::vector<alt_bn128_G1> &a, const std::vector<alt_bn128_G1> &b);
 };
 
 template<mp_size_t m>
@@ -5,7 +5,11 @@
  * @copyright  MIT license (see LICENSE file)
  *****************************************************************************/
 
+#include <algorithm>
+
 #include <libff/algebra/curves/alt_bn128/alt_bn128_g2.hpp>
+#include <libff/algebra/curves/hash_to_curve.hpp>
+#include <libff/algebra/fields/hash_to_field.hpp>
 
 namespace libff {
 
@@ -371,6 +375,20 @@ alt_bn128_G2 alt_bn128_G2::mul_by_q() const
                       (this->Z).Frobenius_map(1));
 }
 
+alt_bn128_G2 alt_bn128_G2::clear_cofactor() const
+{
+    /*
+      Multiply by a multiple of the cofactor 2q-r using the endomorphism
+      psi = mul_by_q, as in Fuentes-Castaneda, Knapp, Rodriguez-Henriquez,
+      "Faster hashing to G2", Section 6.1:
+        [z]P + psi([3z]P) + psi^2([z]P) + psi^3(P)
+      where z is the BN parameter.
+    */
+    const alt_bn128_G2 zP = alt_bn128_final_exponent_z * (*this);
+    const alt_bn128_G2 three_zP = zP.dbl() + zP;
+    return zP + three_zP.mul_by_q() + zP.mul_by_q().mul_by_q() + this->mul_by_q().mul_by_q().mul_by_q();
+}
+
 bool alt_bn128_G2::is_well_formed() const
 {
     if (this->is_zero())
@@ -400,19 +418,87 @@ bool alt_bn128_G2::is_well_formed() const
     }
 }
 
+bool alt_bn128_G2::is_in_subgroup() const
+{
+    /*
+      On G2 the endomorphism psi acts as multiplication by q = 6z^2 (mod r),
+      and for BN curves the converse holds as well (Scott, "A note on group
+      membership tests for G1, G2 and GT on BLS pairing-friendly curves"):
+      a point P of the twist is in G2 if and only if psi(P) = [6z^2]P. This
+      costs a 127-bit scalar multiplication instead of one by the 254-bit
+      group order.
+    */
+    static const bigint<2> six_z_squared("147946756881789318990833708069417712966");
+
+    return this->is_well_formed() && this->mul_by_q() == six_z_squared * (*this);
+}
+
 alt_bn128_G2 alt_bn128_G2::zero()
 {
+    init_alt_bn128_params();
     return G2_zero;
 }
 
 alt_bn128_G2 alt_bn128_G2::one()
 {
+    init_alt_bn128_params();
     return G2_one;
 }
 
 alt_bn128_G2 alt_bn128_G2::random_element()
 {
-    return (alt_bn128_Fr::random_element().as_bigint()) * G2_one;
+    init_alt_bn128_params();
+    return generator_mul<alt_bn128_G2>(alt_bn128_Fr::random_element().as_bigint());
+}
+
+static const svdw_params<alt_bn128_Fq2>& alt_bn128_G2_svdw_params()
+{
+    static const svdw_params<alt_bn128_Fq2> params(alt_bn128_Fq2::zero(), alt_bn128_twist_coeff_b);
+    return params;
+}
+
+/* hash_to_field for Fq2: each element takes two consecutive elements of Fq as coefficients */
+static std::vector<alt_bn128_Fq2> alt_bn128_G2_hash_to_field(const std::string &msg, const std::string &dst)
+{
+    const std::vector<alt_bn128_Fq> e = hash_to_field<alt_bn128_Fq>(msg, dst, 4);
+    return { alt_bn128_Fq2(e[0], e[1]), alt_bn128_Fq2(e[2], e[3]) };
+}
+
+alt_bn128_G2 alt_bn128_G2::map_to_curve(const alt_bn128_Fq2 &u)
+{
+    alt_bn128_Fq2 x, y;
+    svdw_map_to_curve(alt_bn128_G2_svdw_params(), u, x, y);
+    return alt_bn128_G2(x, y, alt_bn128_Fq2::one());
+}
+
+alt_bn128_G2 alt_bn128_G2::hash_to_curve(const std::string &msg, const std::string &dst)
+{
+    const std::vector<alt_bn128_Fq2> u = alt_bn128_G2_hash_to_field(msg, dst);
+    return (map_to_curve(u[0]) + map_to_curve(u[1])).clear_cofactor();
+}
+
+std::vector<alt_bn128_G2> alt_bn128_G2::batch_hash_to_curve(const std::vector<std::string> &msgs, const std::string &dst)
+{
+    std::vector<alt_bn128_Fq2> u;
+    u.reserve(2 * msgs.size());
+    for (const std::string &msg : msgs)
+    {
+        const std::vector<alt_bn128_Fq2> u_msg = alt_bn128_G2_hash_to_field(msg, dst);
+        u.insert(u.end(), u_msg.begin(), u_msg.end());
+    }
+
+    std::vector<alt_bn128_Fq2> x, y;
+    batch_svdw_map_to_curve(alt_bn128_G2_svdw_params(), u, x, y);
+
+    std::vector<alt_bn128_G2> result;
+    result.reserve(msgs.size());
+    for (size_t i = 0; i < msgs.size(); ++i)
+    {
+        result.emplace_back((alt_bn128_G2(x[2*i], y[2*i], alt_bn128_Fq2::one()) +
+                             alt_bn128_G2(x[2*i+1], y[2*i+1], alt_bn128_Fq2::one())).clear_cofactor());
+    }
+
+    return result;
 }
 
 std::ostream& operator<<(std::ostream &out, const alt_bn128_G2 &g)
@@ -432,6 +518,7 @@ std::ostream& operator<<(std::ostream &out, const alt_bn128_G2 &g)
 
 std::istream& operator>>(std::istream &in, alt_bn128_G2 &g)
 {
+    init_alt_bn128_params();
     char is_zero;
     alt_bn128_Fq2 tX, tY;
 
@@ -477,7 +564,21 @@ std::istream& operator>>(std::istream &in, alt_bn128_G2 &g)
     return in;
 }
 
-void alt_bn128_G2::batch_to_special_all_non_zeros(std::vector<alt_bn128_G2> &vec)
+bool alt_bn128_G2::batch_is_in_subgroup(const std::vector<alt_bn128_G2> &vec)
+{
+    std::vector<char> valid(vec.size());
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+    for (size_t i = 0; i < vec.size(); ++i)
+    {
+        valid[i] = vec[i].is_in_subgroup();
+    }
+
+    return std::all_of(valid.begin(), valid.end(), [](const char v) { return v != 0; });
+}
+
+void alt_bn128_G2::batch_to_special(std::vector<alt_bn128_G2> &vec)
 {
     std::vector<alt_bn128_Fq2> Z_vec;
     Z_vec.reserve(vec.size());
@@ -486,12 +587,20 @@ void alt_bn128_G2::batch_to_special_all_non_zeros(std::vector<alt_bn128_G2> &vec
     {
         Z_vec.emplace_back(el.Z);
     }
-    batch_invert<alt_bn128_Fq2>(Z_vec);
+    batch_invert_nonzeros<alt_bn128_Fq2>(Z_vec);
 
     const alt_bn128_Fq2 one = alt_bn128_Fq2::one();
 
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
     for (size_t i = 0; i < vec.size(); ++i)
     {
+        if (Z_vec[i].is_zero())
+        {
+            continue;
+        }
+
         alt_bn128_Fq2 Z2 = Z_vec[i].squared();
         alt_bn128_Fq2 Z3 = Z_vec[i] * Z2;
 
@@ -501,4 +610,41 @@ void alt_bn128_G2::batch_to_special_all_non_zeros(std::vector<alt_bn128_G2> &vec
     }
 }
 
+void alt_bn128_G2::batch_to_special_all_non_zeros(std::vector<alt_bn128_G2> &vec)
+{
+    batch_to_special(vec);
+}
+
+std::vector<alt_bn128_G2> alt_bn128_G2::batch_affine_add(const std::vector<alt_bn128_G2> &a, const std::vector<alt_bn128_G2> &b)
+{
+    ASSERT(a.size() == b.size());
+    const size_t n = a.size();
+
+    std::vector<alt_bn128_Fq2> x1, y1, x2, y2;
+    std::vector<bool> is_zero1(n), is_zero2(n);
+    x1.reserve(n); y1.reserve(n); x2.reserve(n); y2.reserve(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        ASSERT(a[i].is_special() && b[i].is_special());
+        x1.emplace_back(a[i].X);
+        y1.emplace_back(a[i].Y);
+        x2.emplace_back(b[i].X);
+        y2.emplace_back(b[i].Y);
+        is_zero1[i] = a[i].is_zero();
+        is_zero2[i] = b[i].is_zero();
+    }
+
+    std::vector<bool> result_is_zero;
+    batch_affine_add_weierstrass<alt_bn128_Fq2>(alt_bn128_Fq2::zero(), x1, y1, is_zero1, x2, y2, is_zero2, result_is_zero);
+
+    std::vector<alt_bn128_G2> result;
+    result.reserve(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        result.emplace_back(result_is_zero[i] ? alt_bn128_G2::zero() : alt_bn128_G2(x1[i], y1[i], alt_bn128_Fq2::one()));
+    }
+
+    return result;
+}
+
 } // libff
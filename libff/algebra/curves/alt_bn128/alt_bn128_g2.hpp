@@ -7,6 +7,7 @@
 
 #ifndef ALT_BN128_G2_HPP_
 #define ALT_BN128_G2_HPP_
+#include <string>
 #include <vector>
 
 #include <libff/algebra/curves/alt_bn128/alt_bn128_init.hpp>
@@ -61,13 +62,26 @@ public:
     alt_bn128_G2 mixed_add(const alt_bn128_G2 &other) const;
     alt_bn128_G2 dbl() const;
     alt_bn128_G2 mul_by_q() const;
+    alt_bn128_G2 clear_cofactor() const;
 
     bool is_well_formed() const;
+    bool is_in_subgroup() const;
 
     static alt_bn128_G2 zero();
     static alt_bn128_G2 one();
     static alt_bn128_G2 random_element();
 
+    /**
+     * hash_to_curve: as for alt_bn128_G1, over Fq2, followed by
+     * clear_cofactor. The encoding is specific to libff: clear_cofactor
+     * multiplies by the multiple of the cofactor given by the psi formula,
+     * not by a fixed h_eff, so its points differ from those of other BN254
+     * hash-to-curve implementations.
+     */
+    static alt_bn128_G2 map_to_curve(const alt_bn128_Fq2 &u);
+    static alt_bn128_G2 hash_to_curve(const std::string &msg, const std::string &dst);
+    static std::vector<alt_bn128_G2> batch_hash_to_curve(const std::vector<std::string> &msgs, const std::string &dst);
+
     static size_t size_in_bits() { return twist_field::size_in_bits() + 1; }
     static bigint<base_field::num_limbs> base_field_char() { return base_field::field_char(); }
     static bigint<scalar_field::num_limbs> order() { return scalar_field::field_char(); }
@@ -75,7 +89,11 @@ public:
     friend std::ostream& operator<<(std::ostream &out, const alt_bn128_G2 &g);
     friend std::istream& operator>>(std::istream &in, alt_bn128_G2 &g);
 
+    static void batch_to_special(std::vector<alt_bn128_G2> &vec); // in place, zeros are left as they are
     static void batch_to_special_all_non_zeros(std::vector<alt_bn128_G2> &vec);
+    // pairwise sums of two vectors of points in special form, in special form
+    static std::vector<alt_bn128_G2> batch_affine_add(const std::vector<alt_bn128_G2> &a, const std::vector<alt_bn128_G2> &b);
+    static bool batch_is_in_subgroup(const std::vector<alt_bn128_G2> &vec);
 };
 
 template<mp_size_t m>
@@ -5,6 +5,8 @@
  * @copyright  MIT license (see LICENSE file)
  *****************************************************************************/
 
+#include <mutex>
+
 #include <libff/algebra/curves/alt_bn128/alt_bn128_g1.hpp>
 #include <libff/algebra/curves/alt_bn128/alt_bn128_g2.hpp>
 #include <libff/algebra/curves/alt_bn128/alt_bn128_init.hpp>
@@ -28,7 +30,7 @@ bigint<12*alt_bn128_q_limbs> alt_bn128_final_exponent;
 bigint<alt_bn128_q_limbs> alt_bn128_final_exponent_z;
 bool alt_bn128_final_exponent_is_z_neg;
 
-void init_alt_bn128_params()
+static void compute_alt_bn128_params()
 {
     typedef bigint<alt_bn128_r_limbs> bigint_r;
     typedef bigint<alt_bn128_q_limbs> bigint_q;
@@ -272,4 +274,11 @@ void init_alt_bn128_params()
     alt_bn128_final_exponent_is_z_neg = false;
 
 }
+
+void init_alt_bn128_params()
+{
+    static std::once_flag alt_bn128_params_once;
+    std::call_once(alt_bn128_params_once, compute_alt_bn128_params);
+}
+
 } // libff
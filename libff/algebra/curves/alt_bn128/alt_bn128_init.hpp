@@ -48,6 +48,7 @@ extern bigint<12*alt_bn128_q_limbs> alt_bn128_final_exponent;
 extern bigint<alt_bn128_q_limbs> alt_bn128_final_exponent_z;
 extern bool alt_bn128_final_exponent_is_z_neg;
 
+/* Idempotent and thread-safe; alt_bn128_G1 and alt_bn128_G2 call it on first use. */
 void init_alt_bn128_params();
 
 class alt_bn128_G1;
@@ -323,6 +323,9 @@ alt_bn128_ate_G2_precomp alt_bn128_ate_precompute_G2(const alt_bn128_G2& Q)
     bool found_one = false;
     alt_bn128_ate_ell_coeffs c;
 
+    /* at most a doubling and an addition per bit, and the two final additions */
+    result.coeffs.reserve(2 * loop_count.num_bits() + 2);
+
     for (long i = static_cast<long>(loop_count.max_bits()); i >= 0; --i)
     {
         const bool bit = loop_count.test_bit(static_cast<size_t>(i));
@@ -26,6 +26,7 @@ bn::Fp bn128_G1::sqrt(const bn::Fp &el)
     bn::Fp z = bn128_Fq_nqr_to_t;
     bn::Fp w = mie::power(el, bn128_Fq_t_minus_1_over_2);
     bn::Fp x = el * w;
+
     bn::Fp b = x * w;
 
 #if DEBUG
@@ -39,6 +40,12 @@ bn::Fp bn128_G1::sqrt(const bn::Fp &el)
     ASSERT(check == bn::Fp(1));
 #endif
 
+    if (v == 1)
+    {
+        // p = 3 (mod 4), so x = el^((p+1)/4) is already the square root
+        return x;
+    }
+
     // compute square root with Tonelli--Shanks
     // (does not terminate if not a square!)
 
@@ -328,17 +335,20 @@ bn128_G1 bn128_G1::dbl() const
 
 bn128_G1 bn128_G1::zero()
 {
+    init_bn128_params();
     return G1_zero;
 }
 
 bn128_G1 bn128_G1::one()
 {
+    init_bn128_params();
     return G1_one;
 }
 
 bn128_G1 bn128_G1::random_element()
 {
-    return bn128_Fr::random_element().as_bigint() * G1_one;
+    init_bn128_params();
+    return generator_mul<bn128_G1>(bn128_Fr::random_element().as_bigint());
 }
 
 std::ostream& operator<<(std::ostream &out, const bn128_G1 &g)
@@ -403,6 +413,7 @@ bool bn128_G1::is_well_formed() const
 
 std::istream& operator>>(std::istream &in, bn128_G1 &g)
 {
+    init_bn128_params();
     char is_zero;
     in.read((char*)&is_zero, 1); // this reads is_zero;
     is_zero -= '0';
@@ -491,29 +502,60 @@ std::istream& operator>>(std::istream& in, std::vector<bn128_G1> &v)
     return in;
 }
 
-void bn128_G1::batch_to_special_all_non_zeros(std::vector<bn128_G1> &vec)
+void bn128_G1::batch_to_special(std::vector<bn128_G1> &vec)
 {
+    std::vector<size_t> non_zero_indices;
     std::vector<bn::Fp> Z_vec;
+    non_zero_indices.reserve(vec.size());
     Z_vec.reserve(vec.size());
 
-    for (auto &el: vec)
+    for (size_t i = 0; i < vec.size(); ++i)
     {
-        Z_vec.emplace_back(el.coord[2]);
+        if (!vec[i].is_zero())
+        {
+            non_zero_indices.emplace_back(i);
+            Z_vec.emplace_back(vec[i].coord[2]);
+        }
     }
     bn_batch_invert<bn::Fp>(Z_vec);
 
     const bn::Fp one = 1;
 
-    for (size_t i = 0; i < vec.size(); ++i)
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+    for (size_t j = 0; j < non_zero_indices.size(); ++j)
     {
+        bn128_G1 &el = vec[non_zero_indices[j]];
         bn::Fp Z2, Z3;
-        bn::Fp::square(Z2, Z_vec[i]);
-        bn::Fp::mul(Z3, Z2, Z_vec[i]);
+        bn::Fp::square(Z2, Z_vec[j]);
+        bn::Fp::mul(Z3, Z2, Z_vec[j]);
+
+        bn::Fp::mul(el.coord[0], el.coord[0], Z2);
+        bn::Fp::mul(el.coord[1], el.coord[1], Z3);
+        el.coord[2] = one;
+    }
+}
+
+void bn128_G1::batch_to_special_all_non_zeros(std::vector<bn128_G1> &vec)
+{
+    batch_to_special(vec);
+}
 
-        bn::Fp::mul(vec[i].coord[0], vec[i].coord[0], Z2);
-        bn::Fp::mul(vec[i].coord[1], vec[i].coord[1], Z3);
-        vec[i].coord[2] = one;
+std::vector<bn128_G1> bn128_G1::batch_affine_add(const std::vector<bn128_G1> &a, const std::vector<bn128_G1> &b)
+{
+    ASSERT(a.size() == b.size());
+
+    /* the ate-pairing field types have no batch affine formulas here: add in Jacobian coordinates and normalize once */
+    std::vector<bn128_G1> result;
+    result.reserve(a.size());
+    for (size_t i = 0; i < a.size(); ++i)
+    {
+        result.emplace_back(a[i] + b[i]);
     }
+    batch_to_special(result);
+
+    return result;
 }
 
 } // libff
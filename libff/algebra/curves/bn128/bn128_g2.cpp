@@ -358,17 +358,20 @@ bool bn128_G2::is_well_formed() const
 
 bn128_G2 bn128_G2::zero()
 {
+    init_bn128_params();
     return G2_zero;
 }
 
 bn128_G2 bn128_G2::one()
 {
+    init_bn128_params();
     return G2_one;
 }
 
 bn128_G2 bn128_G2::random_element()
 {
-    return bn128_Fr::random_element().as_bigint() * G2_one;
+    init_bn128_params();
+    return generator_mul<bn128_G2>(bn128_Fr::random_element().as_bigint());
 }
 
 std::ostream& operator<<(std::ostream &out, const bn128_G2 &g)
@@ -406,6 +409,7 @@ std::ostream& operator<<(std::ostream &out, const bn128_G2 &g)
 
 std::istream& operator>>(std::istream &in, bn128_G2 &g)
 {
+    init_bn128_params();
     char is_zero;
     in.read((char*)&is_zero, 1); // this reads is_zero;
     is_zero -= '0';
@@ -474,29 +478,60 @@ std::istream& operator>>(std::istream &in, bn128_G2 &g)
     return in;
 }
 
-void bn128_G2::batch_to_special_all_non_zeros(std::vector<bn128_G2> &vec)
+void bn128_G2::batch_to_special(std::vector<bn128_G2> &vec)
 {
+    std::vector<size_t> non_zero_indices;
     std::vector<bn::Fp2> Z_vec;
+    non_zero_indices.reserve(vec.size());
     Z_vec.reserve(vec.size());
 
-    for (auto &el: vec)
+    for (size_t i = 0; i < vec.size(); ++i)
     {
-        Z_vec.emplace_back(el.coord[2]);
+        if (!vec[i].is_zero())
+        {
+            non_zero_indices.emplace_back(i);
+            Z_vec.emplace_back(vec[i].coord[2]);
+        }
     }
     bn_batch_invert<bn::Fp2>(Z_vec);
 
     const bn::Fp2 one = 1;
 
-    for (size_t i = 0; i < vec.size(); ++i)
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+    for (size_t j = 0; j < non_zero_indices.size(); ++j)
     {
+        bn128_G2 &el = vec[non_zero_indices[j]];
         bn::Fp2 Z2, Z3;
-        bn::Fp2::square(Z2, Z_vec[i]);
-        bn::Fp2::mul(Z3, Z2, Z_vec[i]);
+        bn::Fp2::square(Z2, Z_vec[j]);
+        bn::Fp2::mul(Z3, Z2, Z_vec[j]);
+
+        bn::Fp2::mul(el.coord[0], el.coord[0], Z2);
+        bn::Fp2::mul(el.coord[1], el.coord[1], Z3);
+        el.coord[2] = one;
+    }
+}
 
-        bn::Fp2::mul(vec[i].coord[0], vec[i].coord[0], Z2);
-        bn::Fp2::mul(vec[i].coord[1], vec[i].coord[1], Z3);
-        vec[i].coord[2] = one;
+void bn128_G2::batch_to_special_all_non_zeros(std::vector<bn128_G2> &vec)
+{
+    batch_to_special(vec);
+}
+
+std::vector<bn128_G2> bn128_G2::batch_affine_add(const std::vector<bn128_G2> &a, const std::vector<bn128_G2> &b)
+{
+    ASSERT(a.size() == b.size());
+
+    /* the ate-pairing field types have no batch affine formulas here: add in Jacobian coordinates and normalize once */
+    std::vector<bn128_G2> result;
+    result.reserve(a.size());
+    for (size_t i = 0; i < a.size(); ++i)
+    {
+        result.emplace_back(a[i] + b[i]);
     }
+    batch_to_special(result);
+
+    return result;
 }
 
 } // libff
@@ -5,6 +5,8 @@
  * @copyright  MIT license (see LICENSE file)
  *****************************************************************************/
 
+#include <mutex>
+
 #include <libff/algebra/curves/bn128/bn128_g1.hpp>
 #include <libff/algebra/curves/bn128/bn128_g2.hpp>
 #include <libff/algebra/curves/bn128/bn128_gt.hpp>
@@ -25,7 +27,7 @@ size_t bn128_Fq2_s;
 bn::Fp2 bn128_Fq2_nqr_to_t;
 mie::Vuint bn128_Fq2_t_minus_1_over_2;
 
-void init_bn128_params()
+static void compute_bn128_params()
 {
     bn::Param::init(); // init ate-pairing library
 
@@ -223,4 +225,11 @@ void init_bn128_params()
 
     bn128_GT::GT_one.elem = bn::Fp12(1);
 }
+
+void init_bn128_params()
+{
+    static std::once_flag bn128_params_once;
+    std::call_once(bn128_params_once, compute_bn128_params);
+}
+
 } // libff
@@ -36,6 +36,7 @@ extern mie::Vuint bn128_Fq2_t_minus_1_over_2;
 typedef Fp_model<bn128_r_limbs, bn128_modulus_r> bn128_Fr;
 typedef Fp_model<bn128_q_limbs, bn128_modulus_q> bn128_Fq;
 
+/* Idempotent and thread-safe; bn128_G1 and bn128_G2 call it on first use. */
 void init_bn128_params();
 
 class bn128_G1;
@@ -8,14 +8,116 @@
 #ifndef CURVE_UTILS_HPP_
 #define CURVE_UTILS_HPP_
 #include <cstdint>
+#include <vector>
 
 #include <libff/algebra/fields/bigint.hpp>
 
 namespace libff {
 
+/**
+ * Compute scalar * base by wNAF, with the window size picked from
+ * GroupT::wnaf_window_table and, when it pays off, mixed additions from a
+ * normalized table of odd multiples. Variable time: do not use it with
+ * secret scalars.
+ */
 template<typename GroupT, mp_size_t m>
 GroupT scalar_mul(const GroupT &base, const bigint<m> &scalar);
 
+/* Swap a and b if swap is set, without branching on swap. */
+template<typename T>
+void conditional_swap(T &a, T &b, const bool swap);
+
+/**
+ * Compute scalar * base by a Montgomery ladder over all scalar.max_bits()
+ * bits, using conditional swaps, so the sequence of group operations does
+ * not depend on the scalar. The group law itself still branches on special
+ * cases (e.g., the identity), so this hides the scalar only from coarse
+ * timing observers.
+ */
+template<typename GroupT, mp_size_t m>
+GroupT montgomery_ladder_scalar_mul(const GroupT &base, const bigint<m> &scalar);
+
+/* Return table[index], reading every entry of table, so the memory access pattern does not depend on index. */
+template<typename T>
+T constant_time_lookup(const std::vector<T> &table, const size_t index);
+
+/* As above, for the table_size entries starting at table. */
+template<typename T>
+T constant_time_lookup(const T *table, const size_t table_size, const size_t index);
+
+/**
+ * Compute scalar * base with a fixed-window method whose control flow and
+ * memory accesses do not depend on the scalar: the scalar is made odd by
+ * adding the group order if needed, recoded into signed odd digits (Joye and
+ * Tunstall, "Exponent Recoding and Regular Exponentiation Algorithms"), and
+ * every digit is added with a constant-time lookup from a normalized table of
+ * odd multiples of base. base MUST be in the subgroup of order GroupT::order().
+ * As with montgomery_ladder_scalar_mul, the group law itself still branches
+ * on exceptional cases, which random scalars hit with negligible probability.
+ */
+template<typename GroupT, mp_size_t m>
+GroupT constant_time_scalar_mul(const GroupT &base, const bigint<m> &scalar);
+
+/* Constant-time scalar multiplications of one base by many scalars, sharing the table. */
+template<typename GroupT, mp_size_t m>
+std::vector<GroupT> batch_constant_time_scalar_mul(const GroupT &base, const std::vector<bigint<m> > &scalars);
+
+/* Constant-time scalar multiplications bases[i] * scalars[i], normalizing all tables with a single inversion. */
+template<typename GroupT, mp_size_t m>
+std::vector<GroupT> batch_constant_time_scalar_mul(const std::vector<GroupT> &bases, const std::vector<bigint<m> > &scalars);
+
+/**
+ * Pairwise sums of affine points (x1[i], y1[i]) + (x2[i], y2[i]) on the short
+ * Weierstrass curve y^2 = x^3 + coeff_a*x + b, sharing a single inversion.
+ * The sums overwrite (x1, y1); an input flagged in is_zero1/is_zero2 is the
+ * point at infinity, and result_is_zero flags sums that are.
+ */
+template<typename FieldT>
+void batch_affine_add_weierstrass(const FieldT &coeff_a,
+                                  std::vector<FieldT> &x1, std::vector<FieldT> &y1, const std::vector<bool> &is_zero1,
+                                  const std::vector<FieldT> &x2, const std::vector<FieldT> &y2, const std::vector<bool> &is_zero2,
+                                  std::vector<bool> &result_is_zero);
+
+/**
+ * Pairwise sums of points in special inverted coordinates (X = 1/x, Y = 1/y)
+ * on the twisted Edwards curve coeff_a*x^2 + y^2 = 1 + coeff_d*x^2*y^2,
+ * sharing a single inversion. The sums overwrite (X1, Y1). Sums whose result
+ * has x = 0 or y = 0 (not representable in inverted coordinates) are flagged
+ * in exceptional and left unchanged.
+ */
+template<typename FieldT>
+void batch_affine_add_inverted_edwards(const FieldT &coeff_a, const FieldT &coeff_d,
+                                       std::vector<FieldT> &X1, std::vector<FieldT> &Y1,
+                                       const std::vector<FieldT> &X2, const std::vector<FieldT> &Y2,
+                                       std::vector<bool> &exceptional);
+
+/**
+ * Precomputed multiples of a fixed base: for every window i of window_size
+ * bits, the points [d * 2^(window_size * i)] base for d = 1, ..., 2^window_size - 1,
+ * in special (affine) form. A multiplication then costs one mixed addition
+ * per non-zero window and no doublings.
+ */
+template<typename GroupT>
+class fixed_base_mul_table {
+public:
+    size_t window_size;
+    size_t scalar_bits;
+    std::vector<GroupT> table;
+
+    fixed_base_mul_table(const GroupT &base, const size_t scalar_bits, const size_t window_size);
+
+    template<mp_size_t m>
+    GroupT mul(const bigint<m> &scalar) const;
+};
+
+/**
+ * Multiply the generator GroupT::one() by scalar, using a fixed_base_mul_table
+ * with 4-bit windows that is built on first use (after the curve parameters
+ * have been initialized) and shared by the whole process.
+ */
+template<typename GroupT, mp_size_t m>
+GroupT generator_mul(const bigint<m> &scalar);
+
 } // libff
 #include <libff/algebra/curves/curve_utils.tcc>
 
@@ -8,30 +8,483 @@
 #ifndef CURVE_UTILS_TCC_
 #define CURVE_UTILS_TCC_
 
+#include <algorithm>
+#include <type_traits>
+
+#include <libff/algebra/fields/field_utils.hpp>
+#include <libff/algebra/scalar_multiplication/wnaf.hpp>
+#include <libff/common/scratch_arena.hpp>
+
 namespace libff {
 
 template<typename GroupT, mp_size_t m>
 GroupT scalar_mul(const GroupT &base, const bigint<m> &scalar)
 {
+    const size_t scalar_bits = scalar.num_bits();
+
+    size_t window_size = 0;
+    for (long i = static_cast<long>(GroupT::wnaf_window_table.size()) - 1; i >= 0; --i)
+    {
+        if (scalar_bits >= GroupT::wnaf_window_table[static_cast<size_t>(i)])
+        {
+            window_size = static_cast<size_t>(i) + 1;
+            break;
+        }
+    }
+
+    if (window_size == 0 || scalar_bits == m * GMP_NUMB_BITS)
+    {
+        /*
+          Double-and-add for short scalars (or before the window table is
+          initialized), and for scalars using the top bit of the bigint, whose
+          wNAF recoding could overflow it.
+        */
+        GroupT result = GroupT::zero();
+        for (long i = static_cast<long>(scalar_bits) - 1; i >= 0; --i)
+        {
+            result = result.dbl();
+            if (scalar.test_bit(static_cast<size_t>(i)))
+            {
+                result = result + base;
+            }
+        }
+
+        return result;
+    }
+
+    const scratch_scope scope;
+    scratch_vector<long> naf;
+    find_wnaf(naf, window_size, scalar);
+
+    /* table[i] = (2*i+1) * base */
+    std::vector<GroupT> table(1ul << (window_size - 1));
+    const GroupT base_dbl = base.dbl();
+    table[0] = base;
+    for (size_t i = 1; i < table.size(); ++i)
+    {
+        table[i] = table[i-1] + base_dbl;
+    }
+
+    /*
+      Normalizing the table costs one inversion, which pays off once the
+      expected number of additions (about scalar_bits/(window_size+1))
+      exceeds the table size. Points outside the prime-order subgroup may
+      have small-order multiples in the table, which cannot be normalized.
+    */
+    bool use_mixed_addition = (scalar_bits / (window_size + 1) > table.size());
+    for (size_t i = 0; use_mixed_addition && i < table.size(); ++i)
+    {
+        use_mixed_addition = !table[i].is_zero();
+    }
+    if (use_mixed_addition)
+    {
+        GroupT::batch_to_special_all_non_zeros(table);
+    }
+
     GroupT result = GroupT::zero();
+    bool found_nonzero = false;
+    for (long i = static_cast<long>(naf.size() - 1); i >= 0; --i)
+    {
+        if (found_nonzero)
+        {
+            result = result.dbl();
+        }
+
+        const long digit = naf[static_cast<size_t>(i)];
+        if (digit != 0)
+        {
+            found_nonzero = true;
+            const GroupT term = (digit > 0 ? table[digit/2] : -table[(-digit)/2]);
+            result = (use_mixed_addition ? result.mixed_add(term) : result + term);
+        }
+    }
+
+    return result;
+}
+
+template<typename T>
+void conditional_swap(T &a, T &b, const bool swap)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "conditional_swap needs a trivially copyable type");
+
+    const unsigned char mask = static_cast<unsigned char>(-static_cast<int>(swap));
+    unsigned char *a_bytes = reinterpret_cast<unsigned char*>(&a);
+    unsigned char *b_bytes = reinterpret_cast<unsigned char*>(&b);
+    for (size_t i = 0; i < sizeof(T); ++i)
+    {
+        const unsigned char t = mask & (a_bytes[i] ^ b_bytes[i]);
+        a_bytes[i] ^= t;
+        b_bytes[i] ^= t;
+    }
+}
+
+template<typename GroupT, mp_size_t m>
+GroupT montgomery_ladder_scalar_mul(const GroupT &base, const bigint<m> &scalar)
+{
+    /* invariant: R1 - R0 = base */
+    GroupT R0 = GroupT::zero();
+    GroupT R1 = base;
+
+    for (long i = static_cast<long>(scalar.max_bits()) - 1; i >= 0; --i)
+    {
+        const bool bit = scalar.test_bit(static_cast<size_t>(i));
+        conditional_swap(R0, R1, bit);
+        R1 = R0 + R1;
+        R0 = R0.dbl();
+        conditional_swap(R0, R1, bit);
+    }
+
+    return R0;
+}
+
+template<typename T>
+T constant_time_lookup(const std::vector<T> &table, const size_t index)
+{
+    return constant_time_lookup<T>(table.data(), table.size(), index);
+}
+
+template<typename T>
+T constant_time_lookup(const T *table, const size_t table_size, const size_t index)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "constant_time_lookup needs a trivially copyable type");
 
-    bool found_one = false;
-    for (long i = static_cast<long>(scalar.max_bits() - 1); i >= 0; --i)
+    T result;
+    unsigned char *result_bytes = reinterpret_cast<unsigned char*>(&result);
+    std::fill(result_bytes, result_bytes + sizeof(T), 0);
+
+    for (size_t i = 0; i < table_size; ++i)
     {
-        if (found_one)
+        /* mask is 0xff if i == index and 0 otherwise */
+        const size_t diff = i ^ index;
+        const unsigned char mask = static_cast<unsigned char>(((diff | (0 - diff)) >> (8 * sizeof(size_t) - 1)) - 1);
+        const unsigned char *entry_bytes = reinterpret_cast<const unsigned char*>(&table[i]);
+        for (size_t j = 0; j < sizeof(T); ++j)
+        {
+            result_bytes[j] |= mask & entry_bytes[j];
+        }
+    }
+
+    return result;
+}
+
+const size_t constant_time_scalar_mul_window_size = 4;
+
+/* table[i] = (2*i+1) * base for i < 2^(window_size-1), not yet normalized */
+template<typename GroupT>
+std::vector<GroupT> constant_time_scalar_mul_table(const GroupT &base)
+{
+    std::vector<GroupT> table(1ul << (constant_time_scalar_mul_window_size - 1));
+    const GroupT base_dbl = base.dbl();
+    table[0] = base;
+    for (size_t i = 1; i < table.size(); ++i)
+    {
+        table[i] = table[i-1] + base_dbl;
+    }
+
+    return table;
+}
+
+/**
+ * Recode scalar (plus the group order if scalar is even) into signed odd
+ * digits d_0, ..., d_{k-1} with d_{k-1} > 0, returned as table indices
+ * (|d_i|-1)/2 and signs. The number of digits depends only on the types.
+ */
+template<typename GroupT, mp_size_t m>
+void constant_time_scalar_mul_recode(const bigint<m> &scalar, std::vector<size_t> &indices, std::vector<bool> &negative)
+{
+    const size_t w = constant_time_scalar_mul_window_size;
+    const mp_size_t order_limbs = GroupT::scalar_field::num_limbs;
+    const bigint<GroupT::scalar_field::num_limbs> order = GroupT::order();
+
+    /* k = scalar + (1 - scalar mod 2) * order, in a buffer wide enough for the sum */
+    const mp_size_t n = std::max(m, order_limbs) + 1;
+    std::vector<mp_limb_t> k(n, 0), k_plus_order(n, 0), padded_order(n, 0);
+    std::copy(scalar.data, scalar.data + m, k.begin());
+    std::copy(order.data, order.data + order_limbs, padded_order.begin());
+    mpn_add_n(k_plus_order.data(), k.data(), padded_order.data(), n);
+
+    const mp_limb_t mask = (k[0] & 1) - 1;
+    for (mp_size_t i = 0; i < n; ++i)
+    {
+        k[i] ^= mask & (k[i] ^ k_plus_order[i]);
+    }
+
+    /* k < 2^bits, so k_i is small enough for the table after num_digits-1 steps */
+    const size_t bits = std::max(static_cast<size_t>(m * GMP_NUMB_BITS), order.num_bits()) + 1;
+    const size_t num_digits = (bits + w - 1) / w;
+    indices.resize(num_digits);
+    negative.resize(num_digits);
+
+    for (size_t i = 0; i < num_digits; ++i)
+    {
+        long digit;
+        if (i + 1 < num_digits)
+        {
+            /* d_i = (k mod 2^(w+1)) - 2^w, and k = (k - d_i)/2^w = 2*floor(k/2^(w+1)) + 1 */
+            digit = static_cast<long>(k[0] & ((1ul << (w+1)) - 1)) - (1l << w);
+            mpn_rshift(k.data(), k.data(), n, w+1);
+            mpn_lshift(k.data(), k.data(), n, 1);
+            k[0] |= 1;
+        }
+        else
+        {
+            digit = static_cast<long>(k[0]);
+        }
+
+        const long sign = digit >> (8 * sizeof(long) - 1);
+        indices[i] = static_cast<size_t>(((digit ^ sign) - sign - 1) / 2);
+        negative[i] = (sign != 0);
+    }
+}
+
+/* table points to the 2^(w-1) normalized odd multiples built by constant_time_scalar_mul_table */
+template<typename GroupT, mp_size_t m>
+GroupT constant_time_scalar_mul_with_table(const GroupT *table, const bigint<m> &scalar)
+{
+    const size_t table_size = 1ul << (constant_time_scalar_mul_window_size - 1);
+
+    std::vector<size_t> indices;
+    std::vector<bool> negative;
+    constant_time_scalar_mul_recode<GroupT, m>(scalar, indices, negative);
+
+    GroupT result = constant_time_lookup(table, table_size, indices.back());
+    for (long i = static_cast<long>(indices.size()) - 2; i >= 0; --i)
+    {
+        for (size_t j = 0; j < constant_time_scalar_mul_window_size; ++j)
         {
             result = result.dbl();
         }
 
-        if (scalar.test_bit(static_cast<size_t>(i)))
+        GroupT term = constant_time_lookup(table, table_size, indices[static_cast<size_t>(i)]);
+        GroupT negated_term = -term;
+        conditional_swap(term, negated_term, negative[static_cast<size_t>(i)]);
+        result = result.mixed_add(term);
+    }
+
+    return result;
+}
+
+template<typename GroupT, mp_size_t m>
+GroupT constant_time_scalar_mul(const GroupT &base, const bigint<m> &scalar)
+{
+    std::vector<GroupT> table = constant_time_scalar_mul_table(base);
+    GroupT::batch_to_special_all_non_zeros(table);
+    return constant_time_scalar_mul_with_table<GroupT, m>(table.data(), scalar);
+}
+
+template<typename GroupT, mp_size_t m>
+std::vector<GroupT> batch_constant_time_scalar_mul(const GroupT &base, const std::vector<bigint<m> > &scalars)
+{
+    std::vector<GroupT> table = constant_time_scalar_mul_table(base);
+    GroupT::batch_to_special_all_non_zeros(table);
+
+    std::vector<GroupT> result(scalars.size());
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+    for (size_t i = 0; i < scalars.size(); ++i)
+    {
+        result[i] = constant_time_scalar_mul_with_table<GroupT, m>(table.data(), scalars[i]);
+    }
+
+    return result;
+}
+
+template<typename GroupT, mp_size_t m>
+std::vector<GroupT> batch_constant_time_scalar_mul(const std::vector<GroupT> &bases, const std::vector<bigint<m> > &scalars)
+{
+    ASSERT(bases.size() == scalars.size());
+    const size_t table_size = 1ul << (constant_time_scalar_mul_window_size - 1);
+
+    std::vector<GroupT> tables;
+    tables.reserve(bases.size() * table_size);
+    for (const GroupT &base : bases)
+    {
+        const std::vector<GroupT> table = constant_time_scalar_mul_table(base);
+        tables.insert(tables.end(), table.begin(), table.end());
+    }
+    GroupT::batch_to_special_all_non_zeros(tables);
+
+    std::vector<GroupT> result(bases.size());
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+    for (size_t i = 0; i < bases.size(); ++i)
+    {
+        result[i] = constant_time_scalar_mul_with_table<GroupT, m>(&tables[i * table_size], scalars[i]);
+    }
+
+    return result;
+}
+
+template<typename FieldT>
+void batch_affine_add_weierstrass(const FieldT &coeff_a,
+                                  std::vector<FieldT> &x1, std::vector<FieldT> &y1, const std::vector<bool> &is_zero1,
+                                  const std::vector<FieldT> &x2, const std::vector<FieldT> &y2, const std::vector<bool> &is_zero2,
+                                  std::vector<bool> &result_is_zero)
+{
+    const size_t n = x1.size();
+    result_is_zero.assign(n, false);
+
+    /* lambda = (y2-y1)/(x2-x1) for additions, (3*x1^2+a)/(2*y1) for doublings; a zero denominator marks a trivial case */
+    std::vector<FieldT> numerators(n), denominators(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        if (is_zero1[i] || is_zero2[i])
         {
-            found_one = true;
-            result = result + base;
+            denominators[i] = FieldT::zero();
+        }
+        else if (x1[i] != x2[i])
+        {
+            numerators[i] = y2[i] - y1[i];
+            denominators[i] = x2[i] - x1[i];
+        }
+        else if (y1[i] == y2[i] && !y1[i].is_zero())
+        {
+            const FieldT x1_squared = x1[i].squared();
+            numerators[i] = x1_squared + x1_squared + x1_squared + coeff_a;
+            denominators[i] = y1[i] + y1[i];
+        }
+        else
+        {
+            /* P + (-P), including doubling a point of order 2 */
+            denominators[i] = FieldT::zero();
+        }
+    }
+
+    batch_invert_nonzeros<FieldT>(denominators);
+
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+    for (size_t i = 0; i < n; ++i)
+    {
+        if (denominators[i].is_zero())
+        {
+            if (is_zero1[i])
+            {
+                x1[i] = x2[i];
+                y1[i] = y2[i];
+                result_is_zero[i] = is_zero2[i];
+            }
+            else if (!is_zero2[i])
+            {
+                result_is_zero[i] = true;
+            }
+            continue;
+        }
+
+        const FieldT lambda = numerators[i] * denominators[i];
+        const FieldT x3 = lambda.squared() - x1[i] - x2[i];
+        y1[i] = lambda * (x1[i] - x3) - y1[i];
+        x1[i] = x3;
+    }
+}
+
+template<typename FieldT>
+void batch_affine_add_inverted_edwards(const FieldT &coeff_a, const FieldT &coeff_d,
+                                       std::vector<FieldT> &X1, std::vector<FieldT> &Y1,
+                                       const std::vector<FieldT> &X2, const std::vector<FieldT> &Y2,
+                                       std::vector<bool> &exceptional)
+{
+    /*
+      With E = X1*X2*Y1*Y2, the sum is
+        X3 = (E + d)/(X1*Y2 + Y1*X2),  Y3 = (E - d)/(X1*X2 - a*Y1*Y2)
+      (the affine form of addition-madd-2007-lb for inverted coordinates).
+    */
+    const size_t n = X1.size();
+    exceptional.assign(n, false);
+
+    std::vector<FieldT> E(n), denominators(2 * n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        const FieldT C = X1[i] * X2[i];
+        const FieldT D = Y1[i] * Y2[i];
+        E[i] = C * D;
+        denominators[2*i] = X1[i] * Y2[i] + Y1[i] * X2[i];
+        denominators[2*i+1] = C - coeff_a * D;
+        exceptional[i] = (denominators[2*i].is_zero() || denominators[2*i+1].is_zero());
+    }
+
+    batch_invert_nonzeros<FieldT>(denominators);
+
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+    for (size_t i = 0; i < n; ++i)
+    {
+        if (exceptional[i])
+        {
+            continue;
+        }
+
+        X1[i] = (E[i] + coeff_d) * denominators[2*i];
+        Y1[i] = (E[i] - coeff_d) * denominators[2*i+1];
+    }
+}
+
+template<typename GroupT>
+fixed_base_mul_table<GroupT>::fixed_base_mul_table(const GroupT &base, const size_t scalar_bits, const size_t window_size) :
+    window_size(window_size), scalar_bits(scalar_bits)
+{
+    const size_t num_windows = (scalar_bits + window_size - 1) / window_size;
+    const size_t per_window = (1ul << window_size) - 1;
+    table.reserve(num_windows * per_window);
+
+    GroupT window_base = base;
+    for (size_t i = 0; i < num_windows; ++i)
+    {
+        table.emplace_back(window_base);
+        for (size_t d = 1; d < per_window; ++d)
+        {
+            table.emplace_back(table.back() + window_base);
+        }
+        window_base = table.back() + window_base;
+    }
+
+    /* no entry is zero, as the group order is an odd prime larger than 2^window_size */
+    GroupT::batch_to_special_all_non_zeros(table);
+}
+
+template<typename GroupT>
+template<mp_size_t m>
+GroupT fixed_base_mul_table<GroupT>::mul(const bigint<m> &scalar) const
+{
+    const size_t per_window = (1ul << window_size) - 1;
+    const size_t bits = scalar.num_bits();
+    ASSERT(bits <= scalar_bits);
+
+    GroupT result = GroupT::zero();
+    for (size_t i = 0; i * window_size < bits; ++i)
+    {
+        size_t d = 0;
+        for (size_t j = window_size; j > 0; --j)
+        {
+            const size_t bit = i * window_size + j - 1;
+            d = (d << 1) | (bit < bits && scalar.test_bit(bit) ? 1 : 0);
+        }
+
+        if (d != 0)
+        {
+            result = result.mixed_add(table[i * per_window + d - 1]);
         }
     }
 
     return result;
 }
 
+template<typename GroupT, mp_size_t m>
+GroupT generator_mul(const bigint<m> &scalar)
+{
+    static const fixed_base_mul_table<GroupT> table(GroupT::one(), GroupT::scalar_field::size_in_bits(), 4);
+
+    if (scalar.num_bits() > table.scalar_bits)
+    {
+        return scalar_mul<GroupT, m>(GroupT::one(), scalar);
+    }
+
+    return table.mul(scalar);
+}
+
 } // libff
 #endif // CURVE_UTILS_TCC_
@@ -26,6 +26,23 @@ edwards_G1::edwards_G1()
     this->Z = G1_zero.Z;
 }
 
+edwards_G1::edwards_G1(const edwards_G1_extended &P)
+{
+    if (P.X.is_zero())
+    {
+        this->X = G1_zero.X;
+        this->Y = G1_zero.Y;
+        this->Z = G1_zero.Z;
+    }
+    else
+    {
+        // (Z/X, Z/Y) = (P.X/P.Z, P.Y/P.Z) for (X : Y : Z) = (P.Y : P.X : P.T)
+        this->X = P.Y;
+        this->Y = P.X;
+        this->Z = P.T;
+    }
+}
+
 void edwards_G1::print() const
 {
     if (this->is_zero())
@@ -287,17 +304,20 @@ bool edwards_G1::is_well_formed() const
 
 edwards_G1 edwards_G1::zero()
 {
+    init_edwards_params();
     return G1_zero;
 }
 
 edwards_G1 edwards_G1::one()
 {
+    init_edwards_params();
     return G1_one;
 }
 
 edwards_G1 edwards_G1::random_element()
 {
-    return edwards_Fr::random_element().as_bigint() * G1_one;
+    init_edwards_params();
+    return generator_mul<edwards_G1>(edwards_Fr::random_element().as_bigint());
 }
 
 std::ostream& operator<<(std::ostream &out, const edwards_G1 &g)
@@ -316,6 +336,7 @@ std::ostream& operator<<(std::ostream &out, const edwards_G1 &g)
 
 std::istream& operator>>(std::istream &in, edwards_G1 &g)
 {
+    init_edwards_params();
     edwards_Fq tX, tY;
 
 #ifdef NO_PT_COMPRESSION
@@ -388,7 +409,295 @@ std::istream& operator>>(std::istream& in, std::vector<edwards_G1> &v)
     return in;
 }
 
+void edwards_G1::batch_to_special(std::vector<edwards_G1> &vec)
+{
+    std::vector<edwards_Fq> Z_vec;
+    Z_vec.reserve(vec.size());
+
+    for (auto &el: vec)
+    {
+        Z_vec.emplace_back(el.Z);
+    }
+    batch_invert_nonzeros<edwards_Fq>(Z_vec);
+
+    const edwards_Fq one = edwards_Fq::one();
+
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+    for (size_t i = 0; i < vec.size(); ++i)
+    {
+        if (Z_vec[i].is_zero())
+        {
+            continue;
+        }
+
+        vec[i].X = vec[i].X * Z_vec[i];
+        vec[i].Y = vec[i].Y * Z_vec[i];
+        vec[i].Z = one;
+    }
+}
+
 void edwards_G1::batch_to_special_all_non_zeros(std::vector<edwards_G1> &vec)
+{
+    batch_to_special(vec);
+}
+
+std::vector<edwards_G1> edwards_G1::batch_affine_add(const std::vector<edwards_G1> &a, const std::vector<edwards_G1> &b)
+{
+    ASSERT(a.size() == b.size());
+    const size_t n = a.size();
+
+    std::vector<edwards_Fq> X1, Y1, X2, Y2;
+    X1.reserve(n); Y1.reserve(n); X2.reserve(n); Y2.reserve(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        ASSERT(a[i].is_special() && b[i].is_special());
+        X1.emplace_back(a[i].X);
+        Y1.emplace_back(a[i].Y);
+        X2.emplace_back(b[i].X);
+        Y2.emplace_back(b[i].Y);
+    }
+
+    std::vector<bool> exceptional;
+    batch_affine_add_inverted_edwards<edwards_Fq>(edwards_coeff_a, edwards_coeff_d, X1, Y1, X2, Y2, exceptional);
+
+    std::vector<edwards_G1> result;
+    result.reserve(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        if (exceptional[i] || a[i].is_zero() || b[i].is_zero())
+        {
+            edwards_G1 sum = a[i] + b[i];
+            sum.to_special();
+            result.emplace_back(sum);
+        }
+        else
+        {
+            result.emplace_back(edwards_G1(X1[i], Y1[i], edwards_Fq::one()));
+        }
+    }
+
+    return result;
+}
+
+edwards_G1_extended::edwards_G1_extended()
+{
+    this->X = edwards_Fq::zero();
+    this->Y = edwards_Fq::one();
+    this->Z = edwards_Fq::one();
+    this->T = edwards_Fq::zero();
+}
+
+edwards_G1_extended::edwards_G1_extended(const edwards_G1 &P)
+{
+    if (P.is_zero())
+    {
+        this->X = edwards_Fq::zero();
+        this->Y = edwards_Fq::one();
+        this->Z = edwards_Fq::one();
+        this->T = edwards_Fq::zero();
+    }
+    else
+    {
+        // (x, y) = (P.Z/P.X, P.Z/P.Y), scaled by P.X*P.Y
+        this->X = P.Z * P.Y;
+        this->Y = P.Z * P.X;
+        this->Z = P.X * P.Y;
+        this->T = P.Z.squared();
+    }
+}
+
+void edwards_G1_extended::print() const
+{
+    if (this->is_zero())
+    {
+        printf("O\n");
+    }
+    else
+    {
+        edwards_G1_extended copy(*this);
+        copy.to_special();
+        printf("extended edwards_G1 affine x/y:\n");
+        copy.X.print();
+        copy.Y.print();
+    }
+}
+
+void edwards_G1_extended::to_special()
+{
+    if (this->Z == edwards_Fq::one())
+    {
+        return;
+    }
+
+    const edwards_Fq Z_inv = this->Z.inverse();
+    this->X = this->X * Z_inv;
+    this->Y = this->Y * Z_inv;
+    this->T = this->T * Z_inv;
+    this->Z = edwards_Fq::one();
+}
+
+bool edwards_G1_extended::is_special() const
+{
+    return (this->Z == edwards_Fq::one());
+}
+
+bool edwards_G1_extended::is_zero() const
+{
+    return (this->X.is_zero() && this->Y == this->Z);
+}
+
+bool edwards_G1_extended::operator==(const edwards_G1_extended &other) const
+{
+    // X1/Z1 = X2/Z2 <=> X1*Z2 = X2*Z1
+    if ((this->X * other.Z) != (other.X * this->Z))
+    {
+        return false;
+    }
+
+    // Y1/Z1 = Y2/Z2 <=> Y1*Z2 = Y2*Z1
+    if ((this->Y * other.Z) != (other.Y * this->Z))
+    {
+        return false;
+    }
+
+    return true;
+}
+
+bool edwards_G1_extended::operator!=(const edwards_G1_extended &other) const
+{
+    return !(operator==(other));
+}
+
+edwards_G1_extended edwards_G1_extended::operator+(const edwards_G1_extended &other) const
+{
+    return this->add(other);
+}
+
+edwards_G1_extended edwards_G1_extended::operator-() const
+{
+    return edwards_G1_extended(-(this->X), this->Y, this->Z, -(this->T));
+}
+
+edwards_G1_extended edwards_G1_extended::operator-(const edwards_G1_extended &other) const
+{
+    return (*this) + (-other);
+}
+
+edwards_G1_extended edwards_G1_extended::add(const edwards_G1_extended &other) const
+{
+#ifdef PROFILE_OP_COUNTS
+    edwards_G1::add_cnt++;
+#endif
+    // unified, also handles doubling and the identity
+    // http://www.hyperelliptic.org/EFD/g1p/auto-twisted-extended.html#addition-add-2008-hwcd
+
+    const edwards_Fq A = (this->X) * (other.X);                   // A  = X1*X2
+    const edwards_Fq B = (this->Y) * (other.Y);                   // B  = Y1*Y2
+    const edwards_Fq C = edwards_coeff_d * this->T * other.T;     // C  = d*T1*T2
+    const edwards_Fq D = (this->Z) * (other.Z);                   // D  = Z1*Z2
+    const edwards_Fq E = (this->X+this->Y)*(other.X+other.Y)-A-B; // E  = (X1+Y1)*(X2+Y2)-A-B
+    const edwards_Fq F = D-C;                                     // F  = D-C
+    const edwards_Fq G = D+C;                                     // G  = D+C
+    const edwards_Fq H = B-A;                                     // H  = B-A (edwards_a=1)
+    return edwards_G1_extended(E*F, G*H, F*G, E*H); // X3 = E*F, Y3 = G*H, Z3 = F*G, T3 = E*H
+}
+
+edwards_G1_extended edwards_G1_extended::mixed_add(const edwards_G1_extended &other) const
+{
+#ifdef PROFILE_OP_COUNTS
+    edwards_G1::add_cnt++;
+#endif
+#ifdef DEBUG
+    ASSERT(other.is_special());
+#endif
+    // http://www.hyperelliptic.org/EFD/g1p/auto-twisted-extended.html#addition-madd-2008-hwcd
+
+    const edwards_Fq A = (this->X) * (other.X);                   // A  = X1*X2
+    const edwards_Fq B = (this->Y) * (other.Y);                   // B  = Y1*Y2
+    const edwards_Fq C = edwards_coeff_d * this->T * other.T;     // C  = d*T1*T2
+    const edwards_Fq &D = this->Z;                                // D  = Z1
+    const edwards_Fq E = (this->X+this->Y)*(other.X+other.Y)-A-B; // E  = (X1+Y1)*(X2+Y2)-A-B
+    const edwards_Fq F = D-C;                                     // F  = D-C
+    const edwards_Fq G = D+C;                                     // G  = D+C
+    const edwards_Fq H = B-A;                                     // H  = B-A (edwards_a=1)
+    return edwards_G1_extended(E*F, G*H, F*G, E*H); // X3 = E*F, Y3 = G*H, Z3 = F*G, T3 = E*H
+}
+
+edwards_G1_extended edwards_G1_extended::mixed_add(const edwards_G1 &other) const
+{
+    if (other.is_zero())
+    {
+        return *this;
+    }
+
+#ifdef PROFILE_OP_COUNTS
+    edwards_G1::add_cnt++;
+#endif
+#ifdef DEBUG
+    ASSERT(other.is_special());
+#endif
+    // other is (Y2 : X2 : X2*Y2 : 1) in extended coordinates, so T2 = 1
+
+    const edwards_Fq A = (this->X) * (other.Y);                   // A  = X1*X2
+    const edwards_Fq B = (this->Y) * (other.X);                   // B  = Y1*Y2
+    const edwards_Fq C = edwards_coeff_d * this->T;               // C  = d*T1
+    const edwards_Fq D = (this->Z) * (other.X * other.Y);         // D  = Z1*Z2
+    const edwards_Fq E = (this->X+this->Y)*(other.Y+other.X)-A-B; // E  = (X1+Y1)*(X2+Y2)-A-B
+    const edwards_Fq F = D-C;                                     // F  = D-C
+    const edwards_Fq G = D+C;                                     // G  = D+C
+    const edwards_Fq H = B-A;                                     // H  = B-A (edwards_a=1)
+    return edwards_G1_extended(E*F, G*H, F*G, E*H); // X3 = E*F, Y3 = G*H, Z3 = F*G, T3 = E*H
+}
+
+edwards_G1_extended edwards_G1_extended::dbl() const
+{
+#ifdef PROFILE_OP_COUNTS
+    edwards_G1::dbl_cnt++;
+#endif
+    // http://www.hyperelliptic.org/EFD/g1p/auto-twisted-extended.html#doubling-dbl-2008-hwcd
+
+    const edwards_Fq A = (this->X).squared();             // A  = X1^2
+    const edwards_Fq B = (this->Y).squared();             // B  = Y1^2
+    const edwards_Fq ZZ = (this->Z).squared();
+    const edwards_Fq C = ZZ+ZZ;                           // C  = 2*Z1^2
+    const edwards_Fq &D = A;                              // D  = A (edwards_a=1)
+    const edwards_Fq E = (this->X+this->Y).squared()-A-B; // E  = (X1+Y1)^2-A-B
+    const edwards_Fq G = D+B;                             // G  = D+B
+    const edwards_Fq F = G-C;                             // F  = G-C
+    const edwards_Fq H = D-B;                             // H  = D-B
+    return edwards_G1_extended(E*F, G*H, F*G, E*H); // X3 = E*F, Y3 = G*H, Z3 = F*G, T3 = E*H
+}
+
+bool edwards_G1_extended::is_well_formed() const
+{
+    if (this->Z.is_zero() || this->T * this->Z != this->X * this->Y)
+    {
+        return false;
+    }
+
+    /*
+      a x^2 + y^2 = 1 + d x^2 y^2
+
+      becomes, in extended coordinates,
+
+      a X^2 + Y^2 = Z^2 + d T^2
+    */
+    const edwards_Fq X2 = this->X.squared();
+    const edwards_Fq Y2 = this->Y.squared();
+    const edwards_Fq Z2 = this->Z.squared();
+    const edwards_Fq T2 = this->T.squared();
+
+    return (X2 + Y2 == Z2 + edwards_coeff_d * T2);
+}
+
+edwards_G1_extended edwards_G1_extended::zero()
+{
+    return edwards_G1_extended();
+}
+
+void edwards_G1_extended::batch_to_special(std::vector<edwards_G1_extended> &vec)
 {
     std::vector<edwards_Fq> Z_vec;
     Z_vec.reserve(vec.size());
@@ -401,10 +710,14 @@ void edwards_G1::batch_to_special_all_non_zeros(std::vector<edwards_G1> &vec)
 
     const edwards_Fq one = edwards_Fq::one();
 
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
     for (size_t i = 0; i < vec.size(); ++i)
     {
         vec[i].X = vec[i].X * Z_vec[i];
         vec[i].Y = vec[i].Y * Z_vec[i];
+        vec[i].T = vec[i].T * Z_vec[i];
         vec[i].Z = one;
     }
 }
@@ -11,10 +11,12 @@
 
 #include <libff/algebra/curves/curve_utils.hpp>
 #include <libff/algebra/curves/edwards/edwards_init.hpp>
+#include <libff/algebra/scalar_multiplication/multiexp.hpp>
 
 namespace libff {
 
 class edwards_G1;
+class edwards_G1_extended;
 std::ostream& operator<<(std::ostream &, const edwards_G1&);
 std::istream& operator>>(std::istream &, edwards_G1&);
 
@@ -39,6 +41,7 @@ public:
     typedef edwards_Fr scalar_field;
     // using inverted coordinates
     edwards_G1(const edwards_Fq& X, const edwards_Fq& Y) : X(Y), Y(X), Z(X*Y) {};
+    explicit edwards_G1(const edwards_G1_extended &P);
 
     void print() const;
     void print_coordinates() const;
@@ -73,7 +76,59 @@ public:
     friend std::ostream& operator<<(std::ostream &out, const edwards_G1 &g);
     friend std::istream& operator>>(std::istream &in, edwards_G1 &g);
 
+    static void batch_to_special(std::vector<edwards_G1> &vec); // in place, zeros are left as they are
     static void batch_to_special_all_non_zeros(std::vector<edwards_G1> &vec);
+    // pairwise sums of two vectors of points in special form, in special form
+    static std::vector<edwards_G1> batch_affine_add(const std::vector<edwards_G1> &a, const std::vector<edwards_G1> &b);
+};
+
+/**
+ * Points of edwards_G1 in extended twisted Edwards coordinates (X : Y : Z : T),
+ * where x = X/Z, y = Y/Z and T = X*Y/Z (Hisil, Wong, Carter and Dawson,
+ * "Twisted Edwards Curves Revisited", ASIACRYPT 2008). Unlike inverted
+ * coordinates, these represent the identity as (0 : 1 : 1 : 0), and the
+ * same addition formula also handles doubling and the identity, so it is used
+ * to accumulate sums in multi-exponentiation and in pairing preprocessing.
+ */
+class edwards_G1_extended {
+public:
+    edwards_Fq X, Y, Z, T;
+
+    edwards_G1_extended();
+    explicit edwards_G1_extended(const edwards_G1 &P);
+    edwards_G1_extended(const edwards_Fq& X, const edwards_Fq& Y, const edwards_Fq& Z, const edwards_Fq& T) : X(X), Y(Y), Z(Z), T(T) {};
+
+    void print() const;
+
+    void to_special();
+    bool is_special() const;
+
+    bool is_zero() const;
+
+    bool operator==(const edwards_G1_extended &other) const;
+    bool operator!=(const edwards_G1_extended &other) const;
+
+    edwards_G1_extended operator+(const edwards_G1_extended &other) const;
+    edwards_G1_extended operator-() const;
+    edwards_G1_extended operator-(const edwards_G1_extended &other) const;
+
+    edwards_G1_extended add(const edwards_G1_extended &other) const;
+    // other must have Z = 1
+    edwards_G1_extended mixed_add(const edwards_G1_extended &other) const;
+    // other must be in special form, that is, inverted coordinates with Z = 1
+    edwards_G1_extended mixed_add(const edwards_G1 &other) const;
+    edwards_G1_extended dbl() const;
+
+    bool is_well_formed() const;
+
+    static edwards_G1_extended zero();
+
+    static void batch_to_special(std::vector<edwards_G1_extended> &vec);
+};
+
+template<>
+struct multi_exp_accumulator<edwards_G1> {
+    typedef edwards_G1_extended type;
 };
 
 template<mp_size_t m>
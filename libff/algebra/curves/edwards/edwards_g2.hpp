@@ -12,10 +12,12 @@
 
 #include <libff/algebra/curves/curve_utils.hpp>
 #include <libff/algebra/curves/edwards/edwards_init.hpp>
+#include <libff/algebra/scalar_multiplication/multiexp.hpp>
 
 namespace libff {
 
 class edwards_G2;
+class edwards_G2_extended;
 std::ostream& operator<<(std::ostream &, const edwards_G2&);
 std::istream& operator>>(std::istream &, edwards_G2&);
 
@@ -44,6 +46,7 @@ public:
 
     // using inverted coordinates
     edwards_G2(const edwards_Fq3& X, const edwards_Fq3& Y) : X(Y), Y(X), Z(X*Y) {};
+    explicit edwards_G2(const edwards_G2_extended &P);
 
     void print() const;
     void print_coordinates() const;
@@ -79,7 +82,59 @@ public:
     friend std::ostream& operator<<(std::ostream &out, const edwards_G2 &g);
     friend std::istream& operator>>(std::istream &in, edwards_G2 &g);
 
+    static void batch_to_special(std::vector<edwards_G2> &vec); // in place, zeros are left as they are
     static void batch_to_special_all_non_zeros(std::vector<edwards_G2> &vec);
+    // pairwise sums of two vectors of points in special form, in special form
+    static std::vector<edwards_G2> batch_affine_add(const std::vector<edwards_G2> &a, const std::vector<edwards_G2> &b);
+};
+
+/**
+ * Points of edwards_G2 in extended twisted Edwards coordinates (X : Y : Z : T),
+ * where x = X/Z, y = Y/Z and T = X*Y/Z (Hisil, Wong, Carter and Dawson,
+ * "Twisted Edwards Curves Revisited", ASIACRYPT 2008). Unlike inverted
+ * coordinates, these represent the identity as (0 : 1 : 1 : 0), and the
+ * same addition formula also handles doubling and the identity, so it is used
+ * to accumulate sums in multi-exponentiation and in pairing preprocessing.
+ */
+class edwards_G2_extended {
+public:
+    edwards_Fq3 X, Y, Z, T;
+
+    edwards_G2_extended();
+    explicit edwards_G2_extended(const edwards_G2 &P);
+    edwards_G2_extended(const edwards_Fq3& X, const edwards_Fq3& Y, const edwards_Fq3& Z, const edwards_Fq3& T) : X(X), Y(Y), Z(Z), T(T) {};
+
+    void print() const;
+
+    void to_special();
+    bool is_special() const;
+
+    bool is_zero() const;
+
+    bool operator==(const edwards_G2_extended &other) const;
+    bool operator!=(const edwards_G2_extended &other) const;
+
+    edwards_G2_extended operator+(const edwards_G2_extended &other) const;
+    edwards_G2_extended operator-() const;
+    edwards_G2_extended operator-(const edwards_G2_extended &other) const;
+
+    edwards_G2_extended add(const edwards_G2_extended &other) const;
+    // other must have Z = 1
+    edwards_G2_extended mixed_add(const edwards_G2_extended &other) const;
+    // other must be in special form, that is, inverted coordinates with Z = 1
+    edwards_G2_extended mixed_add(const edwards_G2 &other) const;
+    edwards_G2_extended dbl() const;
+
+    bool is_well_formed() const;
+
+    static edwards_G2_extended zero();
+
+    static void batch_to_special(std::vector<edwards_G2_extended> &vec);
+};
+
+template<>
+struct multi_exp_accumulator<edwards_G2> {
+    typedef edwards_G2_extended type;
 };
 
 template<mp_size_t m>
@@ -5,6 +5,8 @@
  * @copyright  MIT license (see LICENSE file)
  *****************************************************************************/
 
+#include <mutex>
+
 #include <libff/algebra/curves/edwards/edwards_g1.hpp>
 #include <libff/algebra/curves/edwards/edwards_g2.hpp>
 #include <libff/algebra/curves/edwards/edwards_init.hpp>
@@ -34,7 +36,7 @@ bigint<edwards_q_limbs> edwards_final_exponent_last_chunk_abs_of_w0;
 bool edwards_final_exponent_last_chunk_is_w0_neg;
 bigint<edwards_q_limbs> edwards_final_exponent_last_chunk_w1;
 
-void init_edwards_params()
+static void compute_edwards_params()
 {
     typedef bigint<edwards_r_limbs> bigint_r;
     typedef bigint<edwards_q_limbs> bigint_q;
@@ -267,4 +269,11 @@ void init_edwards_params()
     edwards_final_exponent_last_chunk_w1 = bigint_q("4");
 
 }
+
+void init_edwards_params()
+{
+    static std::once_flag edwards_params_once;
+    std::call_once(edwards_params_once, compute_edwards_params);
+}
+
 } // libff
@@ -52,6 +52,7 @@ extern bigint<edwards_q_limbs> edwards_final_exponent_last_chunk_abs_of_w0;
 extern bool edwards_final_exponent_last_chunk_is_w0_neg;
 extern bigint<edwards_q_limbs> edwards_final_exponent_last_chunk_w1;
 
+/* Idempotent and thread-safe; edwards_G1 and edwards_G2 call it on first use. */
 void init_edwards_params();
 
 class edwards_G1;
@@ -229,28 +229,7 @@ edwards_tate_G2_precomp edwards_tate_precompute_G2(const edwards_G2& Q)
     return result;
 }
 
-struct extended_edwards_G1_projective {
-    edwards_Fq X;
-    edwards_Fq Y;
-    edwards_Fq Z;
-    edwards_Fq T;
-
-    void print() const
-        {
-            printf("extended edwards_G1 projective X/Y/Z/T:\n");
-            X.print();
-            Y.print();
-            Z.print();
-            T.print();
-        }
-
-    void test_invariant() const
-        {
-            ASSERT(T*Z == X*Y);
-        }
-};
-
-void doubling_step_for_miller_loop(extended_edwards_G1_projective &current,
+void doubling_step_for_miller_loop(edwards_G1_extended &current,
                                    edwards_Fq_conic_coefficients &cc)
 {
     const edwards_Fq &X = current.X, &Y = current.Y, &Z = current.Z, &T = current.T;
@@ -279,12 +258,12 @@ void doubling_step_for_miller_loop(extended_edwards_G1_projective &current,
     current.T = F*(B-H);          // T3 = F*(B-H)
 
 #ifdef DEBUG
-    current.test_invariant();
+    ASSERT(current.is_well_formed());
 #endif
 }
 
-void full_addition_step_for_miller_loop(const extended_edwards_G1_projective &base,
-                                        extended_edwards_G1_projective &current,
+void full_addition_step_for_miller_loop(const edwards_G1_extended &base,
+                                        edwards_G1_extended &current,
                                         edwards_Fq_conic_coefficients &cc)
 {
     const edwards_Fq &X1 = current.X, &Y1 = current.Y, &Z1 = current.Z, &T1 = current.T;
@@ -309,12 +288,12 @@ void full_addition_step_for_miller_loop(const extended_edwards_G1_projective &ba
     current.T = E*H;                  // T3   = E*H
 
 #ifdef DEBUG
-    current.test_invariant();
+    ASSERT(current.is_well_formed());
 #endif
 }
 
-void mixed_addition_step_for_miller_loop(const extended_edwards_G1_projective &base,
-                                         extended_edwards_G1_projective &current,
+void mixed_addition_step_for_miller_loop(const edwards_G1_extended &base,
+                                         edwards_G1_extended &current,
                                          edwards_Fq_conic_coefficients &cc)
 {
     const edwards_Fq &X1 = current.X, &Y1 = current.Y, &Z1 = current.Z, &T1 = current.T;
@@ -339,7 +318,7 @@ void mixed_addition_step_for_miller_loop(const extended_edwards_G1_projective &b
     current.T = E*H;                  // T3   = E*H
 
 #ifdef DEBUG
-    current.test_invariant();
+    ASSERT(current.is_well_formed());
 #endif
 }
 
@@ -348,16 +327,13 @@ edwards_tate_G1_precomp edwards_tate_precompute_G1(const edwards_G1& P)
     enter_block("Call to edwards_tate_precompute_G1");
     edwards_tate_G1_precomp result;
 
-    edwards_G1 Pcopy = P;
-    Pcopy.to_affine_coordinates();
+    edwards_G1_extended P_ext(P);
+    P_ext.to_special();
 
-    extended_edwards_G1_projective P_ext;
-    P_ext.X = Pcopy.X;
-    P_ext.Y = Pcopy.Y;
-    P_ext.Z = Pcopy.Z;
-    P_ext.T = Pcopy.X*Pcopy.Y;
+    edwards_G1_extended R = P_ext;
 
-    extended_edwards_G1_projective R = P_ext;
+    /* at most a doubling and an addition per bit */
+    result.reserve(2 * edwards_modulus_r.num_bits());
 
     bool found_one = false;
     for (long i = static_cast<long>(edwards_modulus_r.max_bits()); i >= 0; --i)
@@ -447,28 +423,7 @@ edwards_GT edwards_tate_reduced_pairing(const edwards_G1 &P, const edwards_G2 &Q
     return result;
 }
 
-struct extended_edwards_G2_projective {
-    edwards_Fq3 X;
-    edwards_Fq3 Y;
-    edwards_Fq3 Z;
-    edwards_Fq3 T;
-
-    void print() const
-        {
-            printf("extended edwards_G2 projective X/Y/Z/T:\n");
-            X.print();
-            Y.print();
-            Z.print();
-            T.print();
-        }
-
-    void test_invariant() const
-        {
-            ASSERT(T*Z == X*Y);
-        }
-};
-
-void doubling_step_for_flipped_miller_loop(extended_edwards_G2_projective &current,
+void doubling_step_for_flipped_miller_loop(edwards_G2_extended &current,
                                            edwards_Fq3_conic_coefficients &cc)
 {
     const edwards_Fq3 &X = current.X, &Y = current.Y, &Z = current.Z, &T = current.T;
@@ -501,12 +456,12 @@ void doubling_step_for_flipped_miller_loop(extended_edwards_G2_projective &curre
     current.Z = I*K;              // Z3 = I*K
     current.T = F*(B-H);          // T3 = F*(B-H)
 #ifdef DEBUG
-    current.test_invariant();
+    ASSERT(current.is_well_formed());
 #endif
 }
 
-void full_addition_step_for_flipped_miller_loop(const extended_edwards_G2_projective &base,
-                                                extended_edwards_G2_projective &current,
+void full_addition_step_for_flipped_miller_loop(const edwards_G2_extended &base,
+                                                edwards_G2_extended &current,
                                                 edwards_Fq3_conic_coefficients &cc)
 {
     const edwards_Fq3 &X1 = current.X, &Y1 = current.Y, &Z1 = current.Z, &T1 = current.T;
@@ -534,12 +489,12 @@ void full_addition_step_for_flipped_miller_loop(const extended_edwards_G2_projec
     current.T = E*H;                  // T3   = E*H
 
 #ifdef DEBUG
-    current.test_invariant();
+    ASSERT(current.is_well_formed());
 #endif
 }
 
-void mixed_addition_step_for_flipped_miller_loop(const extended_edwards_G2_projective &base,
-                                                 extended_edwards_G2_projective &current,
+void mixed_addition_step_for_flipped_miller_loop(const edwards_G2_extended &base,
+                                                 edwards_G2_extended &current,
                                                  edwards_Fq3_conic_coefficients &cc)
 {
     const edwards_Fq3 &X1 = current.X, &Y1 = current.Y, &Z1 = current.Z, &T1 = current.T;
@@ -566,7 +521,7 @@ void mixed_addition_step_for_flipped_miller_loop(const extended_edwards_G2_proje
     current.T = E*H;                  // T3   = E*H
 
 #ifdef DEBUG
-    current.test_invariant();
+    ASSERT(current.is_well_formed());
 #endif
 }
 
@@ -589,16 +544,13 @@ edwards_ate_G2_precomp edwards_ate_precompute_G2(const edwards_G2& Q)
     const bigint<edwards_Fr::num_limbs> &loop_count = edwards_ate_loop_count;
     edwards_ate_G2_precomp result;
 
-    edwards_G2 Qcopy(Q);
-    Qcopy.to_affine_coordinates();
+    edwards_G2_extended Q_ext(Q);
+    Q_ext.to_special();
 
-    extended_edwards_G2_projective Q_ext;
-    Q_ext.X = Qcopy.X;
-    Q_ext.Y = Qcopy.Y;
-    Q_ext.Z = Qcopy.Z;
-    Q_ext.T = Qcopy.X*Qcopy.Y;
+    edwards_G2_extended R = Q_ext;
 
-    extended_edwards_G2_projective R = Q_ext;
+    /* at most a doubling and an addition per bit */
+    result.reserve(2 * loop_count.num_bits());
 
     bool found_one = false;
     for (long i = static_cast<long>(loop_count.max_bits() - 1); i >= 0; --i)
@@ -0,0 +1,64 @@
+/** @file
+ *****************************************************************************
+
+ Declaration of interfaces for the Shallue--van de Woestijne map to curves
+ y^2 = x^3 + A*x + B, following the straight-line description in RFC 9380
+ ("Hashing to Elliptic Curves"), Section 6.6.1.
+
+ The map is not constant time: the selection among the three candidate
+ x-coordinates and the sign of y branch on the input, and the underlying
+ is_square, sqrt and inverse are not constant time themselves. It should only
+ be applied to public inputs.
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef HASH_TO_CURVE_HPP_
+#define HASH_TO_CURVE_HPP_
+
+#include <vector>
+
+#include <libff/algebra/fields/fp.hpp>
+#include <libff/algebra/fields/fp2.hpp>
+
+namespace libff {
+
+/* The sign of a field element (RFC 9380, Section 4.1). */
+template<mp_size_t n, const bigint<n>& modulus>
+bool sgn0(const Fp_model<n, modulus> &el);
+
+template<mp_size_t n, const bigint<n>& modulus>
+bool sgn0(const Fp2_model<n, modulus> &el);
+
+/**
+ * Constants of the SVDW map for the curve y^2 = x^3 + A*x + B. Z is chosen
+ * by the procedure of RFC 9380, Appendix H.1. The encodings built on this
+ * map are specific to libff, and agreement of Z or of the map with other
+ * implementations is not tested.
+ */
+template<typename FieldT>
+class svdw_params {
+public:
+    FieldT A, B;
+    FieldT Z, c1, c2, c3, c4;
+
+    svdw_params(const FieldT &A, const FieldT &B);
+};
+
+/* Map u to the affine point (x, y) on the curve. */
+template<typename FieldT>
+void svdw_map_to_curve(const svdw_params<FieldT> &params, const FieldT &u, FieldT &x, FieldT &y);
+
+/* Map every element of u, sharing a single field inversion among all of them. */
+template<typename FieldT>
+void batch_svdw_map_to_curve(const svdw_params<FieldT> &params, const std::vector<FieldT> &u,
+                             std::vector<FieldT> &x, std::vector<FieldT> &y);
+
+} // libff
+
+#include <libff/algebra/curves/hash_to_curve.tcc>
+
+#endif // HASH_TO_CURVE_HPP_
@@ -0,0 +1,167 @@
+/** @file
+ *****************************************************************************
+
+ Implementation of interfaces for the Shallue--van de Woestijne map.
+
+ See hash_to_curve.hpp .
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef HASH_TO_CURVE_TCC_
+#define HASH_TO_CURVE_TCC_
+
+#include <libff/algebra/fields/field_utils.hpp>
+
+namespace libff {
+
+template<mp_size_t n, const bigint<n>& modulus>
+bool sgn0(const Fp_model<n, modulus> &el)
+{
+    return el.as_bigint().test_bit(0);
+}
+
+template<mp_size_t n, const bigint<n>& modulus>
+bool sgn0(const Fp2_model<n, modulus> &el)
+{
+    const bool sign_0 = sgn0(el.c0);
+    const bool zero_0 = el.c0.is_zero();
+    const bool sign_1 = sgn0(el.c1);
+    return sign_0 || (zero_0 && sign_1);
+}
+
+template<typename FieldT>
+FieldT svdw_curve_rhs(const svdw_params<FieldT> &params, const FieldT &x)
+{
+    return (x.squared() + params.A) * x + params.B;
+}
+
+template<typename FieldT>
+svdw_params<FieldT>::svdw_params(const FieldT &A, const FieldT &B) : A(A), B(B)
+{
+    const FieldT two = FieldT::one() + FieldT::one();
+    const FieldT three = two + FieldT::one();
+    const FieldT four = two + two;
+    const FieldT two_inverse = two.inverse();
+
+    /* find_z_svdw: try 1, -1, 2, -2, ... */
+    FieldT ctr = FieldT::one();
+    bool found = false;
+    while (!found)
+    {
+        const FieldT candidates[2] = { ctr, -ctr };
+        for (const FieldT &Z_cand : candidates)
+        {
+            const FieldT g = svdw_curve_rhs(*this, Z_cand);
+            if (g.is_zero())
+            {
+                continue;
+            }
+
+            const FieldT h_num = three * Z_cand.squared() + four * A;
+            const FieldT h = -h_num * (four * g).inverse();
+            if (h.is_zero() || !h.is_square())
+            {
+                continue;
+            }
+
+            if (g.is_square() || svdw_curve_rhs(*this, -Z_cand * two_inverse).is_square())
+            {
+                this->Z = Z_cand;
+                found = true;
+                break;
+            }
+        }
+        ctr = ctr + FieldT::one();
+    }
+
+    const FieldT g_Z = svdw_curve_rhs(*this, Z);
+    const FieldT tv = three * Z.squared() + four * A;
+
+    c1 = g_Z;
+    c2 = -Z * two_inverse;
+    c3 = (-g_Z * tv).sqrt();
+    if (sgn0(c3))
+    {
+        c3 = -c3;
+    }
+    c4 = -four * g_Z * tv.inverse();
+}
+
+/* Steps 1-5 of the map: returns the element whose inverse is needed. */
+template<typename FieldT>
+FieldT svdw_map_to_curve_denominator(const svdw_params<FieldT> &params, const FieldT &u, FieldT &tv1, FieldT &tv2)
+{
+    const FieldT c1_u_squared = u.squared() * params.c1;
+    tv2 = FieldT::one() + c1_u_squared;
+    tv1 = FieldT::one() - c1_u_squared;
+    return tv1 * tv2;
+}
+
+/* Steps 7-36 of the map, given tv3 = inv0(tv1 * tv2). */
+template<typename FieldT>
+void svdw_map_to_curve_finish(const svdw_params<FieldT> &params, const FieldT &u,
+                              const FieldT &tv1, const FieldT &tv2, const FieldT &tv3,
+                              FieldT &x, FieldT &y)
+{
+    const FieldT tv4 = u * tv1 * tv3 * params.c3;
+
+    const FieldT x1 = params.c2 - tv4;
+    const bool e1 = svdw_curve_rhs(params, x1).is_square();
+
+    const FieldT x2 = params.c2 + tv4;
+    const bool e2 = svdw_curve_rhs(params, x2).is_square() && !e1;
+
+    const FieldT x3 = (tv2.squared() * tv3).squared() * params.c4 + params.Z;
+
+    x = e1 ? x1 : (e2 ? x2 : x3);
+    y = svdw_curve_rhs(params, x).sqrt();
+    if (sgn0(u) != sgn0(y))
+    {
+        y = -y;
+    }
+}
+
+template<typename FieldT>
+void svdw_map_to_curve(const svdw_params<FieldT> &params, const FieldT &u, FieldT &x, FieldT &y)
+{
+    FieldT tv1, tv2;
+    const FieldT tv3 = svdw_map_to_curve_denominator(params, u, tv1, tv2);
+    svdw_map_to_curve_finish(params, u, tv1, tv2, tv3.is_zero() ? tv3 : tv3.inverse(), x, y);
+}
+
+template<typename FieldT>
+void batch_svdw_map_to_curve(const svdw_params<FieldT> &params, const std::vector<FieldT> &u,
+                             std::vector<FieldT> &x, std::vector<FieldT> &y)
+{
+    const size_t n = u.size();
+    std::vector<FieldT> tv1(n), tv2(n), tv3(n);
+    std::vector<bool> is_zero(n);
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        tv3[i] = svdw_map_to_curve_denominator(params, u[i], tv1[i], tv2[i]);
+        /* inv0(0) = 0; substitute one so the batch inversion stays defined */
+        is_zero[i] = tv3[i].is_zero();
+        if (is_zero[i])
+        {
+            tv3[i] = FieldT::one();
+        }
+    }
+
+    batch_invert<FieldT>(tv3);
+
+    x.resize(n);
+    y.resize(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        svdw_map_to_curve_finish(params, u[i], tv1[i], tv2[i], is_zero[i] ? FieldT::zero() : tv3[i], x[i], y[i]);
+    }
+}
+
+} // libff
+
+#endif // HASH_TO_CURVE_TCC_
@@ -83,7 +83,10 @@ public:
     friend std::ostream& operator<<(std::ostream &out, const mnt4_G1 &g);
     friend std::istream& operator>>(std::istream &in, mnt4_G1 &g);
 
+    static void batch_to_special(std::vector<mnt4_G1> &vec); // in place, zeros are left as they are
     static void batch_to_special_all_non_zeros(std::vector<mnt4_G1> &vec);
+    // pairwise sums of two vectors of points in special form, in special form
+    static std::vector<mnt4_G1> batch_affine_add(const std::vector<mnt4_G1> &a, const std::vector<mnt4_G1> &b);
 };
 
 template<mp_size_t m>
@@ -11,6 +11,8 @@
  * @copyright  MIT license (see LICENSE file)
  *****************************************************************************/
 
+#include <mutex>
+
 #include <libff/algebra/curves/mnt/mnt4/mnt4_g1.hpp>
 #include <libff/algebra/curves/mnt/mnt4/mnt4_g2.hpp>
 #include <libff/algebra/curves/mnt/mnt4/mnt4_init.hpp>
@@ -37,62 +39,12 @@ bigint<mnt4_q_limbs> mnt4_final_exponent_last_chunk_abs_of_w0;
 bool mnt4_final_exponent_last_chunk_is_w0_neg;
 bigint<mnt4_q_limbs> mnt4_final_exponent_last_chunk_w1;
 
-void init_mnt4_params()
+static void compute_mnt4_params()
 {
-    typedef bigint<mnt4_r_limbs> bigint_r;
     typedef bigint<mnt4_q_limbs> bigint_q;
 
-    ASSERT(sizeof(mp_limb_t) == 8 || sizeof(mp_limb_t) == 4); // Montgomery assumes this
-
-    /* parameters for scalar field Fr */
-    mnt4_modulus_r = bigint_r("475922286169261325753349249653048451545124878552823515553267735739164647307408490559963137");
-    ASSERT(mnt4_Fr::modulus_is_valid());
-    if (sizeof(mp_limb_t) == 8)
-    {
-        mnt4_Fr::Rsquared = bigint_r("163983144722506446826715124368972380525894397127205577781234305496325861831001705438796139");
-        mnt4_Fr::Rcubed = bigint_r("207236281459091063710247635236340312578688659363066707916716212805695955118593239854980171");
-        mnt4_Fr::inv = 0xbb4334a3ffffffff;
-    }
-    if (sizeof(mp_limb_t) == 4)
-    {
-        mnt4_Fr::Rsquared = bigint_r("163983144722506446826715124368972380525894397127205577781234305496325861831001705438796139");
-        mnt4_Fr::Rcubed = bigint_r("207236281459091063710247635236340312578688659363066707916716212805695955118593239854980171");
-        mnt4_Fr::inv = 0xffffffff;
-    }
-    mnt4_Fr::num_bits = 298;
-    mnt4_Fr::euler = bigint_r("237961143084630662876674624826524225772562439276411757776633867869582323653704245279981568");
-    mnt4_Fr::s = 34;
-    mnt4_Fr::t = bigint_r("27702323054502562488973446286577291993024111641153199339359284829066871159442729");
-    mnt4_Fr::t_minus_1_over_2 = bigint_r("13851161527251281244486723143288645996512055820576599669679642414533435579721364");
-    mnt4_Fr::multiplicative_generator = mnt4_Fr("10");
-    mnt4_Fr::root_of_unity = mnt4_Fr("120638817826913173458768829485690099845377008030891618010109772937363554409782252579816313");
-    mnt4_Fr::nqr = mnt4_Fr("5");
-    mnt4_Fr::nqr_to_t = mnt4_Fr("406220604243090401056429458730298145937262552508985450684842547562990900634752279902740880");
-
-    /* parameters for base field Fq */
-    mnt4_modulus_q = bigint_q("475922286169261325753349249653048451545124879242694725395555128576210262817955800483758081");
-    ASSERT(mnt4_Fq::modulus_is_valid());
-    if (sizeof(mp_limb_t) == 8)
-    {
-        mnt4_Fq::Rsquared = bigint_q("273000478523237720910981655601160860640083126627235719712980612296263966512828033847775776");
-        mnt4_Fq::Rcubed = bigint_q("427298980065529822574935274648041073124704261331681436071990730954930769758106792920349077");
-        mnt4_Fq::inv = 0xb071a1b67165ffff;
-    }
-    if (sizeof(mp_limb_t) == 4)
-    {
-        mnt4_Fq::Rsquared = bigint_q("273000478523237720910981655601160860640083126627235719712980612296263966512828033847775776");
-        mnt4_Fq::Rcubed = bigint_q("427298980065529822574935274648041073124704261331681436071990730954930769758106792920349077");
-        mnt4_Fq::inv = 0x7165ffff;
-    }
-    mnt4_Fq::num_bits = 298;
-    mnt4_Fq::euler = bigint_q("237961143084630662876674624826524225772562439621347362697777564288105131408977900241879040");
-    mnt4_Fq::s = 17;
-    mnt4_Fq::t = bigint_q("3630998887399759870554727551674258816109656366292531779446068791017229177993437198515");
-    mnt4_Fq::t_minus_1_over_2 = bigint_q("1815499443699879935277363775837129408054828183146265889723034395508614588996718599257");
-    mnt4_Fq::multiplicative_generator = mnt4_Fq("17");
-    mnt4_Fq::root_of_unity = mnt4_Fq("264706250571800080758069302369654305530125675521263976034054878017580902343339784464690243");
-    mnt4_Fq::nqr = mnt4_Fq("17");
-    mnt4_Fq::nqr_to_t = mnt4_Fq("264706250571800080758069302369654305530125675521263976034054878017580902343339784464690243");
+    /* Fr and Fq are shared with the other MNT curve */
+    init_mnt46_fields();
 
     /* parameters for twist field Fq2 */
     mnt4_Fq2::euler = bigint<2*mnt4_q_limbs>("113251011236288135098249345249154230895914381858788918106847214243419142422924133497460817468249854833067260038985710370091920860837014281886963086681184370139950267830740466401280");
@@ -262,4 +214,10 @@ void init_mnt4_params()
     mnt4_final_exponent_last_chunk_w1 = bigint_q("1");
 }
 
+void init_mnt4_params()
+{
+    static std::once_flag mnt4_params_once;
+    std::call_once(mnt4_params_once, compute_mnt4_params);
+}
+
 } // libff
@@ -57,6 +57,7 @@ extern bigint<mnt4_q_limbs> mnt4_final_exponent_last_chunk_abs_of_w0;
 extern bool mnt4_final_exponent_last_chunk_is_w0_neg;
 extern bigint<mnt4_q_limbs> mnt4_final_exponent_last_chunk_w1;
 
+/* Idempotent and thread-safe; mnt4_G1 and mnt4_G2 call it on first use. */
 void init_mnt4_params();
 
 class mnt4_G1;
@@ -258,6 +258,8 @@ mnt4_affine_ate_G2_precomputation mnt4_affine_ate_precompute_G2(const mnt4_G2& Q
     bool found_nonzero = false;
 
     std::vector<long> NAF = find_wnaf(1, loop_count);
+    /* at most a doubling and an addition per digit */
+    result.coeffs.reserve(2 * NAF.size());
     for (long i = static_cast<long>(NAF.size() - 1); i >= 0; --i)
     {
         if (!found_nonzero)
@@ -503,6 +505,10 @@ mnt4_ate_G2_precomp mnt4_ate_precompute_G2(const mnt4_G2& Q)
     const bigint<mnt4_Fr::num_limbs> &loop_count = mnt4_ate_loop_count;
     bool found_one = false;
 
+    /* at most a doubling and an addition per bit, and the final addition */
+    result.dbl_coeffs.reserve(loop_count.num_bits());
+    result.add_coeffs.reserve(loop_count.num_bits() + 1);
+
     for (long i = static_cast<long>(loop_count.max_bits() - 1); i >= 0; --i)
     {
         const bool bit = loop_count.test_bit(static_cast<size_t>(i));
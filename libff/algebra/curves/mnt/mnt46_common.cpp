@@ -11,11 +11,79 @@
  * @copyright  MIT license (see LICENSE file)
  *****************************************************************************/
 
+#include <mutex>
+
 #include <libff/algebra/curves/mnt/mnt46_common.hpp>
+#include <libff/algebra/fields/fp.hpp>
+#include <libff/common/assert.hpp>
 
 namespace libff {
 
 bigint<mnt46_A_limbs> mnt46_modulus_A;
 bigint<mnt46_B_limbs> mnt46_modulus_B;
 
+typedef Fp_model<mnt46_A_limbs, mnt46_modulus_A> mnt46_Fp_A;
+typedef Fp_model<mnt46_B_limbs, mnt46_modulus_B> mnt46_Fp_B;
+
+static void compute_mnt46_fields()
+{
+    ASSERT(sizeof(mp_limb_t) == 8 || sizeof(mp_limb_t) == 4); // Montgomery assumes this
+
+    /* the scalar field of MNT4 and base field of MNT6 */
+    mnt46_modulus_A = bigint<mnt46_A_limbs>("475922286169261325753349249653048451545124878552823515553267735739164647307408490559963137");
+    ASSERT(mnt46_Fp_A::modulus_is_valid());
+    if (sizeof(mp_limb_t) == 8)
+    {
+        mnt46_Fp_A::Rsquared = bigint<mnt46_A_limbs>("163983144722506446826715124368972380525894397127205577781234305496325861831001705438796139");
+        mnt46_Fp_A::Rcubed = bigint<mnt46_A_limbs>("207236281459091063710247635236340312578688659363066707916716212805695955118593239854980171");
+        mnt46_Fp_A::inv = 0xbb4334a3ffffffff;
+    }
+    if (sizeof(mp_limb_t) == 4)
+    {
+        mnt46_Fp_A::Rsquared = bigint<mnt46_A_limbs>("163983144722506446826715124368972380525894397127205577781234305496325861831001705438796139");
+        mnt46_Fp_A::Rcubed = bigint<mnt46_A_limbs>("207236281459091063710247635236340312578688659363066707916716212805695955118593239854980171");
+        mnt46_Fp_A::inv = 0xffffffff;
+    }
+    mnt46_Fp_A::num_bits = 298;
+    mnt46_Fp_A::euler = bigint<mnt46_A_limbs>("237961143084630662876674624826524225772562439276411757776633867869582323653704245279981568");
+    mnt46_Fp_A::s = 34;
+    mnt46_Fp_A::t = bigint<mnt46_A_limbs>("27702323054502562488973446286577291993024111641153199339359284829066871159442729");
+    mnt46_Fp_A::t_minus_1_over_2 = bigint<mnt46_A_limbs>("13851161527251281244486723143288645996512055820576599669679642414533435579721364");
+    mnt46_Fp_A::multiplicative_generator = mnt46_Fp_A("10");
+    mnt46_Fp_A::root_of_unity = mnt46_Fp_A("120638817826913173458768829485690099845377008030891618010109772937363554409782252579816313");
+    mnt46_Fp_A::nqr = mnt46_Fp_A("5");
+    mnt46_Fp_A::nqr_to_t = mnt46_Fp_A("406220604243090401056429458730298145937262552508985450684842547562990900634752279902740880");
+
+    /* the base field of MNT4 and scalar field of MNT6 */
+    mnt46_modulus_B = bigint<mnt46_B_limbs>("475922286169261325753349249653048451545124879242694725395555128576210262817955800483758081");
+    ASSERT(mnt46_Fp_B::modulus_is_valid());
+    if (sizeof(mp_limb_t) == 8)
+    {
+        mnt46_Fp_B::Rsquared = bigint<mnt46_B_limbs>("273000478523237720910981655601160860640083126627235719712980612296263966512828033847775776");
+        mnt46_Fp_B::Rcubed = bigint<mnt46_B_limbs>("427298980065529822574935274648041073124704261331681436071990730954930769758106792920349077");
+        mnt46_Fp_B::inv = 0xb071a1b67165ffff;
+    }
+    if (sizeof(mp_limb_t) == 4)
+    {
+        mnt46_Fp_B::Rsquared = bigint<mnt46_B_limbs>("273000478523237720910981655601160860640083126627235719712980612296263966512828033847775776");
+        mnt46_Fp_B::Rcubed = bigint<mnt46_B_limbs>("427298980065529822574935274648041073124704261331681436071990730954930769758106792920349077");
+        mnt46_Fp_B::inv = 0x7165ffff;
+    }
+    mnt46_Fp_B::num_bits = 298;
+    mnt46_Fp_B::euler = bigint<mnt46_B_limbs>("237961143084630662876674624826524225772562439621347362697777564288105131408977900241879040");
+    mnt46_Fp_B::s = 17;
+    mnt46_Fp_B::t = bigint<mnt46_B_limbs>("3630998887399759870554727551674258816109656366292531779446068791017229177993437198515");
+    mnt46_Fp_B::t_minus_1_over_2 = bigint<mnt46_B_limbs>("1815499443699879935277363775837129408054828183146265889723034395508614588996718599257");
+    mnt46_Fp_B::multiplicative_generator = mnt46_Fp_B("17");
+    mnt46_Fp_B::root_of_unity = mnt46_Fp_B("264706250571800080758069302369654305530125675521263976034054878017580902343339784464690243");
+    mnt46_Fp_B::nqr = mnt46_Fp_B("17");
+    mnt46_Fp_B::nqr_to_t = mnt46_Fp_B("264706250571800080758069302369654305530125675521263976034054878017580902343339784464690243");
+}
+
+void init_mnt46_fields()
+{
+    static std::once_flag mnt46_fields_once;
+    std::call_once(mnt46_fields_once, compute_mnt46_fields);
+}
+
 } // libff
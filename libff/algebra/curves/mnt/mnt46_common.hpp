@@ -25,6 +25,13 @@ const mp_size_t mnt46_B_limbs = (mnt46_B_bitcount+GMP_NUMB_BITS-1)/GMP_NUMB_BITS
 extern bigint<mnt46_A_limbs> mnt46_modulus_A;
 extern bigint<mnt46_B_limbs> mnt46_modulus_B;
 
+/**
+ * Initializes the two prime fields shared by MNT4 and MNT6 (modulus A is
+ * the scalar field of MNT4 and the base field of MNT6, modulus B the
+ * reverse). Called by both curves' initialization; runs once per process.
+ */
+void init_mnt46_fields();
+
 } // libff
 
 #endif
@@ -373,17 +373,20 @@ bool mnt6_G1::is_well_formed() const
 
 mnt6_G1 mnt6_G1::zero()
 {
+    init_mnt6_params();
     return G1_zero;
 }
 
 mnt6_G1 mnt6_G1::one()
 {
+    init_mnt6_params();
     return G1_one;
 }
 
 mnt6_G1 mnt6_G1::random_element()
 {
-    return (scalar_field::random_element().as_bigint()) * G1_one;
+    init_mnt6_params();
+    return generator_mul<mnt6_G1>(scalar_field::random_element().as_bigint());
 }
 
 std::ostream& operator<<(std::ostream &out, const mnt6_G1 &g)
@@ -404,6 +407,7 @@ std::ostream& operator<<(std::ostream &out, const mnt6_G1 &g)
 
 std::istream& operator>>(std::istream &in, mnt6_G1 &g)
 {
+    init_mnt6_params();
     char is_zero;
     mnt6_Fq tX, tY;
 
@@ -481,7 +485,7 @@ std::istream& operator>>(std::istream& in, std::vector<mnt6_G1> &v)
     return in;
 }
 
-void mnt6_G1::batch_to_special_all_non_zeros(std::vector<mnt6_G1> &vec)
+void mnt6_G1::batch_to_special(std::vector<mnt6_G1> &vec)
 {
     std::vector<mnt6_Fq> Z_vec;
     Z_vec.reserve(vec.size());
@@ -490,14 +494,59 @@ void mnt6_G1::batch_to_special_all_non_zeros(std::vector<mnt6_G1> &vec)
     {
         Z_vec.emplace_back(el.Z());
     }
-    batch_invert<mnt6_Fq>(Z_vec);
+    batch_invert_nonzeros<mnt6_Fq>(Z_vec);
 
     const mnt6_Fq one = mnt6_Fq::one();
 
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
     for (size_t i = 0; i < vec.size(); ++i)
     {
+        if (Z_vec[i].is_zero())
+        {
+            continue;
+        }
+
         vec[i] = mnt6_G1(vec[i].X() * Z_vec[i], vec[i].Y() * Z_vec[i], one);
     }
 }
 
+void mnt6_G1::batch_to_special_all_non_zeros(std::vector<mnt6_G1> &vec)
+{
+    batch_to_special(vec);
+}
+
+std::vector<mnt6_G1> mnt6_G1::batch_affine_add(const std::vector<mnt6_G1> &a, const std::vector<mnt6_G1> &b)
+{
+    ASSERT(a.size() == b.size());
+    const size_t n = a.size();
+
+    std::vector<mnt6_Fq> x1, y1, x2, y2;
+    std::vector<bool> is_zero1(n), is_zero2(n);
+    x1.reserve(n); y1.reserve(n); x2.reserve(n); y2.reserve(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        ASSERT(a[i].is_special() && b[i].is_special());
+        x1.emplace_back(a[i].X());
+        y1.emplace_back(a[i].Y());
+        x2.emplace_back(b[i].X());
+        y2.emplace_back(b[i].Y());
+        is_zero1[i] = a[i].is_zero();
+        is_zero2[i] = b[i].is_zero();
+    }
+
+    std::vector<bool> result_is_zero;
+    batch_affine_add_weierstrass<mnt6_Fq>(mnt6_G1::coeff_a, x1, y1, is_zero1, x2, y2, is_zero2, result_is_zero);
+
+    std::vector<mnt6_G1> result;
+    result.reserve(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        result.emplace_back(result_is_zero[i] ? mnt6_G1::zero() : mnt6_G1(x1[i], y1[i], mnt6_Fq::one()));
+    }
+
+    return result;
+}
+
 } // libff
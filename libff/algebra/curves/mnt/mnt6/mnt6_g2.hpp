@@ -88,7 +88,10 @@ public:
     friend std::ostream& operator<<(std::ostream &out, const mnt6_G2 &g);
     friend std::istream& operator>>(std::istream &in, mnt6_G2 &g);
 
+    static void batch_to_special(std::vector<mnt6_G2> &vec); // in place, zeros are left as they are
     static void batch_to_special_all_non_zeros(std::vector<mnt6_G2> &vec);
+    // pairwise sums of two vectors of points in special form, in special form
+    static std::vector<mnt6_G2> batch_affine_add(const std::vector<mnt6_G2> &a, const std::vector<mnt6_G2> &b);
 };
 
 template<mp_size_t m>
@@ -11,6 +11,8 @@
  * @copyright  MIT license (see LICENSE file)
  *****************************************************************************/
 
+#include <mutex>
+
 #include <libff/algebra/curves/mnt/mnt6/mnt6_g1.hpp>
 #include <libff/algebra/curves/mnt/mnt6/mnt6_g2.hpp>
 #include <libff/algebra/curves/mnt/mnt6/mnt6_init.hpp>
@@ -39,62 +41,12 @@ bigint<mnt6_q_limbs> mnt6_final_exponent_last_chunk_abs_of_w0;
 bool mnt6_final_exponent_last_chunk_is_w0_neg;
 bigint<mnt6_q_limbs> mnt6_final_exponent_last_chunk_w1;
 
-void init_mnt6_params()
+static void compute_mnt6_params()
 {
-    typedef bigint<mnt6_r_limbs> bigint_r;
     typedef bigint<mnt6_q_limbs> bigint_q;
 
-    ASSERT(sizeof(mp_limb_t) == 8 || sizeof(mp_limb_t) == 4); // Montgomery assumes this
-
-    /* parameters for scalar field Fr */
-    mnt6_modulus_r = bigint_r("475922286169261325753349249653048451545124879242694725395555128576210262817955800483758081");
-    ASSERT(mnt6_Fr::modulus_is_valid());
-    if (sizeof(mp_limb_t) == 8)
-    {
-        mnt6_Fr::Rsquared = bigint_r("273000478523237720910981655601160860640083126627235719712980612296263966512828033847775776");
-        mnt6_Fr::Rcubed = bigint_r("427298980065529822574935274648041073124704261331681436071990730954930769758106792920349077");
-        mnt6_Fr::inv = 0xb071a1b67165ffff;
-    }
-    if (sizeof(mp_limb_t) == 4)
-    {
-        mnt6_Fr::Rsquared = bigint_r("273000478523237720910981655601160860640083126627235719712980612296263966512828033847775776");
-        mnt6_Fr::Rcubed = bigint_r("427298980065529822574935274648041073124704261331681436071990730954930769758106792920349077");
-        mnt6_Fr::inv = 0x7165ffff;
-    }
-    mnt6_Fr::num_bits = 298;
-    mnt6_Fr::euler = bigint_r("237961143084630662876674624826524225772562439621347362697777564288105131408977900241879040");
-    mnt6_Fr::s = 17;
-    mnt6_Fr::t = bigint_r("3630998887399759870554727551674258816109656366292531779446068791017229177993437198515");
-    mnt6_Fr::t_minus_1_over_2 = bigint_r("1815499443699879935277363775837129408054828183146265889723034395508614588996718599257");
-    mnt6_Fr::multiplicative_generator = mnt6_Fr("17");
-    mnt6_Fr::root_of_unity = mnt6_Fr("264706250571800080758069302369654305530125675521263976034054878017580902343339784464690243");
-    mnt6_Fr::nqr = mnt6_Fr("17");
-    mnt6_Fr::nqr_to_t = mnt6_Fr("264706250571800080758069302369654305530125675521263976034054878017580902343339784464690243");
-
-    /* parameters for base field Fq */
-    mnt6_modulus_q = bigint_q("475922286169261325753349249653048451545124878552823515553267735739164647307408490559963137");
-    ASSERT(mnt6_Fq::modulus_is_valid());
-    if (sizeof(mp_limb_t) == 8)
-    {
-        mnt6_Fq::Rsquared = bigint_q("163983144722506446826715124368972380525894397127205577781234305496325861831001705438796139");
-        mnt6_Fq::Rcubed = bigint_q("207236281459091063710247635236340312578688659363066707916716212805695955118593239854980171");
-        mnt6_Fq::inv = 0xbb4334a3ffffffff;
-    }
-    if (sizeof(mp_limb_t) == 4)
-    {
-        mnt6_Fq::Rsquared = bigint_q("163983144722506446826715124368972380525894397127205577781234305496325861831001705438796139");
-        mnt6_Fq::Rcubed = bigint_q("207236281459091063710247635236340312578688659363066707916716212805695955118593239854980171");
-        mnt6_Fq::inv = 0xffffffff;
-    }
-    mnt6_Fq::num_bits = 298;
-    mnt6_Fq::euler = bigint_q("237961143084630662876674624826524225772562439276411757776633867869582323653704245279981568");
-    mnt6_Fq::s = 34;
-    mnt6_Fq::t = bigint_q("27702323054502562488973446286577291993024111641153199339359284829066871159442729");
-    mnt6_Fq::t_minus_1_over_2 = bigint_q("13851161527251281244486723143288645996512055820576599669679642414533435579721364");
-    mnt6_Fq::multiplicative_generator = mnt6_Fq("10");
-    mnt6_Fq::root_of_unity = mnt6_Fq("120638817826913173458768829485690099845377008030891618010109772937363554409782252579816313");
-    mnt6_Fq::nqr = mnt6_Fq("5");
-    mnt6_Fq::nqr_to_t = mnt6_Fq("406220604243090401056429458730298145937262552508985450684842547562990900634752279902740880");
+    /* Fr and Fq are shared with the other MNT curve */
+    init_mnt46_fields();
 
     /* parameters for twist field Fq3 */
     mnt6_Fq3::euler = bigint<3*mnt6_q_limbs>("53898680178554951715397245154796036139463891589001478629193136369124915637741423690184935056189295242736833704290747216410090671804540908400210778934462129625646263095398323485795557551284190224166851571615834194321908328559167529729507439069424158411618728014749106176");
@@ -274,4 +226,10 @@ void init_mnt6_params()
     mnt6_final_exponent_last_chunk_w1 = bigint_q("1");
 }
 
+void init_mnt6_params()
+{
+    static std::once_flag mnt6_params_once;
+    std::call_once(mnt6_params_once, compute_mnt6_params);
+}
+
 } // libff
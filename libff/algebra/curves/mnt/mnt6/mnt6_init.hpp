@@ -59,6 +59,7 @@ extern bigint<mnt6_q_limbs> mnt6_final_exponent_last_chunk_abs_of_w0;
 extern bool mnt6_final_exponent_last_chunk_is_w0_neg;
 extern bigint<mnt6_q_limbs> mnt6_final_exponent_last_chunk_w1;
 
+/* Idempotent and thread-safe; mnt6_G1 and mnt6_G2 call it on first use. */
 void init_mnt6_params();
 
 class mnt6_G1;
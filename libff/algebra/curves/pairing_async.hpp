@@ -0,0 +1,41 @@
+/** @file
+ *****************************************************************************
+
+ Declaration of asynchronous variants of the reduced pairing.
+
+ Each function queues EC_ppT's pairing on task_scheduler::global() with the
+ given priority and returns a future for the result. The points are copied,
+ so they need not outlive the call.
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef PAIRING_ASYNC_HPP_
+#define PAIRING_ASYNC_HPP_
+
+#include <future>
+
+#include <libff/algebra/curves/public_params.hpp>
+#include <libff/common/task_scheduler.hpp>
+
+namespace libff {
+
+template<typename EC_ppT>
+std::future<GT<EC_ppT> > reduced_pairing_async(const G1<EC_ppT> &P,
+                                               const G2<EC_ppT> &Q,
+                                               const task_priority priority = task_priority_normal);
+
+/* only for curves that implement affine_reduced_pairing (MNT4 and MNT6) */
+template<typename EC_ppT>
+std::future<GT<EC_ppT> > affine_reduced_pairing_async(const G1<EC_ppT> &P,
+                                                      const G2<EC_ppT> &Q,
+                                                      const task_priority priority = task_priority_normal);
+
+} // libff
+
+#include <libff/algebra/curves/pairing_async.tcc>
+
+#endif // PAIRING_ASYNC_HPP_
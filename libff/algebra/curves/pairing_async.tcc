@@ -0,0 +1,41 @@
+/** @file
+ *****************************************************************************
+
+ Implementation of asynchronous variants of the reduced pairing.
+
+ See pairing_async.hpp .
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef PAIRING_ASYNC_TCC_
+#define PAIRING_ASYNC_TCC_
+
+namespace libff {
+
+template<typename EC_ppT>
+std::future<GT<EC_ppT> > reduced_pairing_async(const G1<EC_ppT> &P,
+                                               const G2<EC_ppT> &Q,
+                                               const task_priority priority)
+{
+    return task_scheduler::global().submit([P, Q]() {
+        return EC_ppT::reduced_pairing(P, Q);
+    }, priority);
+}
+
+template<typename EC_ppT>
+std::future<GT<EC_ppT> > affine_reduced_pairing_async(const G1<EC_ppT> &P,
+                                                      const G2<EC_ppT> &Q,
+                                                      const task_priority priority)
+{
+    return task_scheduler::global().submit([P, Q]() {
+        return EC_ppT::affine_reduced_pairing(P, Q);
+    }, priority);
+}
+
+} // libff
+
+#endif // PAIRING_ASYNC_TCC_
@@ -31,6 +31,11 @@ namespace libff {
 
   void init_public_params();
 
+  init_public_params() must be idempotent and thread-safe. The group
+  accessors (zero(), one(), random_element()) and point deserialization
+  initialize their curve on first use, so only code that works with field
+  elements before touching any group needs to call it.
+
   GT<EC_ppT> final_exponentiation(const Fqk<EC_ppT> &elt);
 
   G1_precomp<EC_ppT> precompute_G1(const G1<EC_ppT> &P);
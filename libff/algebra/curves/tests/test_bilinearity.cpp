@@ -12,6 +12,7 @@
 #include <libff/algebra/curves/alt_bn128/alt_bn128_pp.hpp>
 #include <libff/algebra/curves/mnt/mnt4/mnt4_pp.hpp>
 #include <libff/algebra/curves/mnt/mnt6/mnt6_pp.hpp>
+#include <libff/algebra/curves/pairing_async.hpp>
 
 using namespace libff;
 
@@ -43,11 +44,14 @@ void pairing_test()
     GT<ppT> ans1 = ppT::reduced_pairing(sP, Q);
     GT<ppT> ans2 = ppT::reduced_pairing(P, sQ);
     GT<ppT> ans3 = ppT::reduced_pairing(P, Q)^s;
+    std::future<GT<ppT> > ans4 = reduced_pairing_async<ppT>(sP, Q, task_priority_high);
     ans1.print();
     ans2.print();
     ans3.print();
     ASSERT(ans1 == ans2);
     ASSERT(ans2 == ans3);
+    const GT<ppT> ans4_result = ans4.get();
+    ASSERT(ans4_result == ans1);
 
     ASSERT(ans1 != GT_one);
     ASSERT((ans1^Fr<ppT>::field_char()) == GT_one);
@@ -96,11 +100,14 @@ void affine_pairing_test()
     GT<ppT> ans1 = ppT::affine_reduced_pairing(sP, Q);
     GT<ppT> ans2 = ppT::affine_reduced_pairing(P, sQ);
     GT<ppT> ans3 = ppT::affine_reduced_pairing(P, Q)^s;
+    std::future<GT<ppT> > ans4 = affine_reduced_pairing_async<ppT>(P, sQ);
     ans1.print();
     ans2.print();
     ans3.print();
     ASSERT(ans1 == ans2);
     ASSERT(ans2 == ans3);
+    const GT<ppT> ans4_result = ans4.get();
+    ASSERT(ans4_result == ans2);
 
     ASSERT(ans1 != GT_one);
     ASSERT((ans1^Fr<ppT>::field_char()) == GT_one);
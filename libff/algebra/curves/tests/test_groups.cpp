@@ -12,8 +12,17 @@
 #include <libff/algebra/curves/bn128/bn128_pp.hpp>
 #endif
 #include <sstream>
+#include <thread>
 
 #include <libff/algebra/curves/alt_bn128/alt_bn128_pp.hpp>
+#include <libff/algebra/fields/hash_to_field.hpp>
+#include <libff/algebra/scalar_multiplication/multiexp.hpp>
+#include <libff/algebra/scalar_multiplication/multiexp_async.hpp>
+#include <libff/algebra/scalar_multiplication/multiexp_incremental.hpp>
+#include <libff/algebra/scalar_multiplication/multiexp_plan.hpp>
+#include <libff/algebra/scalar_multiplication/multiexp_shard.hpp>
+#include <libff/common/huge_pages.hpp>
+#include <libff/common/scratch_arena.hpp>
 
 using namespace libff;
 
@@ -119,6 +128,322 @@ void test_mul_by_q()
     ASSERT((GroupT::base_field_char()*a) == a.mul_by_q());
 }
 
+template<typename GroupT>
+void test_generator_mul()
+{
+    typedef typename GroupT::scalar_field Fr;
+
+    ASSERT(generator_mul<GroupT>(Fr::zero().as_bigint()) == GroupT::zero());
+    ASSERT(generator_mul<GroupT>(Fr::one().as_bigint()) == GroupT::one());
+    ASSERT(generator_mul<GroupT>((-Fr::one()).as_bigint()) == -GroupT::one());
+
+    for (size_t i = 0; i < 10; ++i)
+    {
+        const Fr s = Fr::random_element();
+        ASSERT(generator_mul<GroupT>(s.as_bigint()) == scalar_mul<GroupT>(GroupT::one(), s.as_bigint()));
+    }
+}
+
+template<typename GroupT>
+void test_scalar_mul()
+{
+    typedef typename GroupT::scalar_field Fr;
+
+    const GroupT base = GroupT::random_element();
+    ASSERT(scalar_mul<GroupT>(base, bigint<1>(0ul)) == GroupT::zero());
+    ASSERT(scalar_mul<GroupT>(base, bigint<1>(1ul)) == base);
+    ASSERT(scalar_mul<GroupT>(base, bigint<1>(~0ul)) == montgomery_ladder_scalar_mul<GroupT>(base, bigint<1>(~0ul)));
+    ASSERT(scalar_mul<GroupT>(GroupT::zero(), Fr::random_element().as_bigint()) == GroupT::zero());
+
+    for (size_t i = 0; i < 10; ++i)
+    {
+        const bigint<Fr::num_limbs> s = Fr::random_element().as_bigint();
+        const GroupT expected = montgomery_ladder_scalar_mul<GroupT>(base, s);
+        ASSERT(scalar_mul<GroupT>(base, s) == expected);
+        ASSERT(fixed_window_wnaf_exp<GroupT>(1, base, s) == expected);
+        ASSERT(constant_time_scalar_mul<GroupT>(base, s) == expected);
+    }
+
+    ASSERT(constant_time_scalar_mul<GroupT>(base, bigint<1>(0ul)) == GroupT::zero());
+    ASSERT(constant_time_scalar_mul<GroupT>(base, bigint<1>(1ul)) == base);
+    ASSERT(constant_time_scalar_mul<GroupT>(base, bigint<1>(~0ul)) == scalar_mul<GroupT>(base, bigint<1>(~0ul)));
+    ASSERT(constant_time_scalar_mul<GroupT>(base, GroupT::order()) == GroupT::zero());
+
+    std::vector<GroupT> bases;
+    std::vector<bigint<Fr::num_limbs> > scalars;
+    for (size_t i = 0; i < 5; ++i)
+    {
+        bases.emplace_back(GroupT::random_element());
+        scalars.emplace_back(Fr::random_element().as_bigint());
+    }
+    const std::vector<GroupT> same_base = batch_constant_time_scalar_mul<GroupT>(base, scalars);
+    const std::vector<GroupT> many_bases = batch_constant_time_scalar_mul<GroupT>(bases, scalars);
+    for (size_t i = 0; i < scalars.size(); ++i)
+    {
+        ASSERT(same_base[i] == scalar_mul<GroupT>(base, scalars[i]));
+        ASSERT(many_bases[i] == scalar_mul<GroupT>(bases[i], scalars[i]));
+    }
+}
+
+template<typename GroupT>
+void test_batch_affine()
+{
+    std::vector<GroupT> vec, expected;
+    for (size_t i = 0; i < 10; ++i)
+    {
+        vec.emplace_back(i % 3 == 0 ? GroupT::zero() : GroupT::random_element());
+    }
+    expected = vec;
+    GroupT::batch_to_special(vec);
+    for (size_t i = 0; i < vec.size(); ++i)
+    {
+        ASSERT(vec[i].is_special());
+        ASSERT(vec[i] == expected[i]);
+    }
+
+    /* generic sums, doublings, P + (-P) and sums with zero */
+    const GroupT P = vec[1];
+    std::vector<GroupT> a = { vec[1], vec[2], P, P, GroupT::zero(), P, GroupT::zero() };
+    std::vector<GroupT> b = { vec[4], vec[5], P, -P, P, GroupT::zero(), GroupT::zero() };
+    GroupT::batch_to_special(a);
+    GroupT::batch_to_special(b);
+    const std::vector<GroupT> sums = GroupT::batch_affine_add(a, b);
+    ASSERT(sums.size() == a.size());
+    for (size_t i = 0; i < a.size(); ++i)
+    {
+        ASSERT(sums[i].is_special());
+        ASSERT(sums[i] == a[i] + b[i]);
+    }
+}
+
+template<typename GroupT, typename ExtendedT>
+void test_extended_edwards()
+{
+    const GroupT zero = GroupT::zero();
+    const GroupT a = GroupT::random_element();
+    const GroupT b = GroupT::random_element();
+    const ExtendedT ea(a), eb(b), ezero(zero);
+
+    ASSERT(ea.is_well_formed());
+    ASSERT(ezero.is_well_formed());
+    ASSERT(ezero.is_zero());
+    ASSERT(ezero == ExtendedT::zero());
+    ASSERT(!ea.is_zero());
+    ASSERT(GroupT(ea) == a);
+    ASSERT(GroupT(ezero) == zero);
+
+    ASSERT(GroupT(ea + eb) == a + b);
+    ASSERT(GroupT(ea + ea) == a.dbl());
+    ASSERT(GroupT(ea.dbl()) == a.dbl());
+    ASSERT(ea + ezero == ea);
+    ASSERT(ezero + ea == ea);
+    ASSERT((ea - ea).is_zero());
+    ASSERT(GroupT(ea - eb) == a - b);
+    ASSERT((ea + eb).is_well_formed());
+    ASSERT(ea.dbl().is_well_formed());
+
+    GroupT special_b = b;
+    special_b.to_special();
+    ASSERT(GroupT(ea.mixed_add(special_b)) == a + b);
+    ASSERT(ea.mixed_add(zero) == ea);
+    ASSERT(GroupT(ezero.mixed_add(special_b)) == b);
+
+    std::vector<ExtendedT> vec = { ea, eb, ezero, ea + eb };
+    const std::vector<ExtendedT> expected = vec;
+    ExtendedT::batch_to_special(vec);
+    for (size_t i = 0; i < vec.size(); ++i)
+    {
+        ASSERT(vec[i].is_special());
+        ASSERT(vec[i] == expected[i]);
+    }
+    ASSERT(GroupT(ea.mixed_add(vec[1])) == a + b);
+    ASSERT(ea.mixed_add(vec[2]) == ea);
+}
+
+template<typename GroupT>
+void test_multi_exp()
+{
+    typedef typename GroupT::scalar_field Fr;
+
+    std::vector<GroupT> bases;
+    std::vector<Fr> scalars;
+    for (size_t i = 0; i < 100; ++i)
+    {
+        bases.emplace_back(i % 10 == 0 ? GroupT::zero() : GroupT::random_element());
+        scalars.emplace_back(i % 7 == 0 ? Fr::zero() : Fr::random_element());
+    }
+#ifdef USE_MIXED_ADDITION
+    GroupT::batch_to_special(bases);
+#endif
+
+    GroupT expected = GroupT::zero();
+    for (size_t i = 0; i < bases.size(); ++i)
+    {
+        expected = expected + scalars[i] * bases[i];
+    }
+    ASSERT((multi_exp<GroupT, Fr, multi_exp_method_naive_plain>(
+                bases.cbegin(), bases.cend(), scalars.cbegin(), scalars.cend(), 1)) == expected);
+    ASSERT((multi_exp<GroupT, Fr, multi_exp_method_naive>(
+                bases.cbegin(), bases.cend(), scalars.cbegin(), scalars.cend(), 2)) == expected);
+    ASSERT((multi_exp<GroupT, Fr, multi_exp_method_BDLO12>(
+                bases.cbegin(), bases.cend(), scalars.cbegin(), scalars.cend(), 1)) == expected);
+    ASSERT((multi_exp<GroupT, Fr, multi_exp_method_BDLO12>(
+                bases.cbegin(), bases.cend(), scalars.cbegin(), scalars.cend(), 3)) == expected);
+    ASSERT((multi_exp<GroupT, Fr, multi_exp_method_bos_coster>(
+                bases.cbegin(), bases.cend(), scalars.cbegin(), scalars.cend(), 1)) == expected);
+    ASSERT((multi_exp<GroupT, Fr, multi_exp_method_straus>(
+                bases.cbegin(), bases.cend(), scalars.cbegin(), scalars.cend(), 2)) == expected);
+
+    /* scalars already in canonical form */
+    typedef bigint<Fr::num_limbs> BigIntT;
+    std::vector<BigIntT> bn_scalars;
+    vector_as_bigints(bn_scalars, scalars);
+    ASSERT((multi_exp<GroupT, BigIntT, multi_exp_method_BDLO12>(
+                bases.cbegin(), bases.cend(), bn_scalars.cbegin(), bn_scalars.cend(), 3)) == expected);
+    ASSERT((multi_exp<GroupT, BigIntT, multi_exp_method_bos_coster>(
+                bases.cbegin(), bases.cend(), bn_scalars.cbegin(), bn_scalars.cend(), 1)) == expected);
+    ASSERT((multi_exp_with_mixed_addition<GroupT, BigIntT, multi_exp_method_BDLO12>(
+                bases.cbegin(), bases.cend(), bn_scalars.cbegin(), bn_scalars.cend(), 1)) == expected);
+    ASSERT((multi_exp_with_mixed_addition<GroupT, Fr, multi_exp_method_BDLO12>(
+                bases.cbegin(), bases.cend(), scalars.cbegin(), scalars.cend(), 1)) == expected);
+
+    /* recoded once, reused */
+    const multi_exp_recoded_scalars recoded(scalars);
+    ASSERT(multi_exp<GroupT>(bases.cbegin(), bases.cend(), recoded, 1) == expected);
+    ASSERT(multi_exp<GroupT>(bases.cbegin(), bases.cend(), recoded, 3) == expected);
+    const multi_exp_recoded_scalars recoded_bn(bn_scalars, 5);
+    ASSERT(multi_exp<GroupT>(bases.cbegin(), bases.cend(), recoded_bn, 2) == expected);
+
+    /* planned under a generous and a tight memory budget */
+    const multi_exp_plan loose_plan = plan_multi_exp<GroupT, Fr>(bases.size(), 1ul << 30, 4);
+    const multi_exp_plan tight_plan = plan_multi_exp<GroupT, Fr>(bases.size(), 4096, 4);
+    const multi_exp_plan bn_plan = plan_multi_exp<GroupT, BigIntT>(bases.size(), 1ul << 16);
+    ASSERT(loose_plan.fits_budget);
+    ASSERT(tight_plan.estimated_memory <= loose_plan.estimated_memory);
+    ASSERT(tight_plan.estimated_cost >= loose_plan.estimated_cost);
+    ASSERT(bn_plan.scalar_copy == multi_exp_scalar_copy_none);
+    /* each running thread commits at least one arena chunk */
+    ASSERT(tight_plan.estimated_memory >= tight_plan.num_threads * scratch_arena::min_chunk_size);
+    ASSERT(!tight_plan.fits_budget);
+    /* capacity the caller keeps on purpose survives a planned call */
+    scratch_arena::thread_arena().reset();
+    const size_t retained_capacity = scratch_arena::thread_arena().capacity();
+    ASSERT(retained_capacity > 0);
+    ASSERT((multi_exp_planned<GroupT, Fr>(
+                bases.cbegin(), bases.cend(), scalars.cbegin(), scalars.cend(), loose_plan)) == expected);
+    ASSERT((multi_exp_planned<GroupT, Fr>(
+                bases.cbegin(), bases.cend(), scalars.cbegin(), scalars.cend(), tight_plan)) == expected);
+    ASSERT((multi_exp_planned<GroupT, BigIntT>(
+                bases.cbegin(), bases.cend(), bn_scalars.cbegin(), bn_scalars.cend(), bn_plan)) == expected);
+    /* chunks the tiles added are not retained */
+    ASSERT(scratch_arena::thread_arena().capacity() == retained_capacity);
+    multi_exp_plan bdlo12_plan = tight_plan;
+    bdlo12_plan.method = multi_exp_method_BDLO12;
+    bdlo12_plan.window_size = 3;
+    bdlo12_plan.num_tiles = 7;
+    bdlo12_plan.scalar_copy = multi_exp_scalar_copy_per_tile;
+    ASSERT((multi_exp_planned<GroupT, Fr>(
+                bases.cbegin(), bases.cend(), scalars.cbegin(), scalars.cend(), bdlo12_plan)) == expected);
+
+    /* shards computed and serialized separately, combined in any order */
+    std::vector<multi_exp_shard<GroupT> > shards;
+    const size_t shard_bounds[] = { 0, 30, 31, 100 };
+    for (size_t s = 3; s > 0; --s)
+    {
+        const multi_exp_shard<GroupT> shard = multi_exp_shard_compute<GroupT, Fr>(
+            bases.cbegin() + shard_bounds[s-1], bases.cbegin() + shard_bounds[s],
+            scalars.cbegin() + shard_bounds[s-1], scalars.cbegin() + shard_bounds[s], 6, 2);
+        std::stringstream ss;
+        ss << shard;
+        multi_exp_shard<GroupT> read_shard;
+        ss >> read_shard;
+        ASSERT(read_shard == shard);
+        shards.emplace_back(read_shard);
+    }
+    ASSERT(multi_exp_combine_shards(shards) == expected);
+
+    /* incremental updates, in a small batch, a large batch and singly */
+    typedef multi_exp_incremental<GroupT, Fr> incremental;
+    incremental commitment(bases, scalars, 2);
+    ASSERT(commitment.value() == expected);
+    std::vector<Fr> new_scalars = scalars;
+    std::vector<typename incremental::update> small_batch;
+    for (size_t i = 0; i < 10; ++i)
+    {
+        const size_t index = (i * 37) % bases.size();
+        const Fr value = Fr::random_element();
+        small_batch.push_back({ index, new_scalars[index], value });
+        new_scalars[index] = value;
+    }
+    commitment.apply(small_batch);
+    std::vector<typename incremental::update> large_batch;
+    for (size_t i = 0; i < incremental::straus_threshold; ++i)
+    {
+        const size_t index = i % bases.size();
+        const Fr value = (i % 5 == 0 ? new_scalars[index] : Fr::random_element());
+        large_batch.push_back({ index, new_scalars[index], value });
+        new_scalars[index] = value;
+    }
+    commitment.apply(large_batch, 2);
+    const Fr value = Fr::random_element();
+    commitment.apply(3, new_scalars[3], value);
+    new_scalars[3] = value;
+    ASSERT((commitment.value() == multi_exp<GroupT, Fr, multi_exp_method_BDLO12>(
+                bases.cbegin(), bases.cend(), new_scalars.cbegin(), new_scalars.cend(), 1)));
+
+    /* huge-page backed bases and window tables */
+    huge_pages = huge_pages_transparent;
+    std::vector<GroupT> hp_bases;
+    resize_with_huge_pages(hp_bases, bases.size(), 3);
+    std::copy(bases.begin(), bases.end(), hp_bases.begin());
+    ASSERT((multi_exp<GroupT, Fr, multi_exp_method_BDLO12>(
+                hp_bases.cbegin(), hp_bases.cend(), scalars.cbegin(), scalars.cend(), 3)) == expected);
+    const window_table<GroupT> hp_table = get_window_table(Fr::size_in_bits(), 4, bases[1]);
+    huge_pages = huge_pages_off;
+    ASSERT(hp_table == get_window_table(Fr::size_in_bits(), 4, bases[1]));
+
+    /* asynchronous variants */
+    std::future<GroupT> msm_low = multi_exp_async<GroupT, Fr, multi_exp_method_BDLO12>(
+        bases.cbegin(), bases.cend(), scalars.cbegin(), scalars.cend(), 2, task_priority_low);
+    std::future<GroupT> msm_high = multi_exp_async<GroupT>(
+        bases.cbegin(), bases.cend(), recoded, 1, task_priority_high);
+    std::future<std::vector<GroupT> > powers = batch_exp_async<GroupT, Fr>(
+        Fr::size_in_bits(), 4, hp_table, scalars);
+    const GroupT msm_low_result = msm_low.get();
+    const GroupT msm_high_result = msm_high.get();
+    const std::vector<GroupT> powers_result = powers.get();
+    ASSERT(msm_low_result == expected);
+    ASSERT(msm_high_result == expected);
+    ASSERT((powers_result == batch_exp<GroupT, Fr>(Fr::size_in_bits(), 4, hp_table, scalars)));
+}
+
+template<typename ppT>
+void test_batch_exp_dual()
+{
+    typedef Fr<ppT> FieldT;
+    const size_t scalar_size = FieldT::size_in_bits();
+
+    std::vector<FieldT> v;
+    for (size_t i = 0; i < 300; ++i)
+    {
+        v.emplace_back(i % 50 == 0 ? FieldT::zero() : FieldT::random_element());
+    }
+    const FieldT coeff = FieldT::random_element();
+    const window_table<G1<ppT> > table1 = get_window_table(scalar_size, 5, G1<ppT>::random_element());
+    const window_table<G2<ppT> > table2 = get_window_table(scalar_size, 5, G2<ppT>::random_element());
+    const window_table<G2<ppT> > table2_narrow = get_window_table(scalar_size, 3, table2[0][1]);
+
+    const std::pair<std::vector<G1<ppT> >, std::vector<G2<ppT> > > same_window =
+        batch_exp_dual<G1<ppT>, G2<ppT>, FieldT>(scalar_size, 5, table1, 5, table2, v);
+    ASSERT((same_window.first == batch_exp<G1<ppT>, FieldT>(scalar_size, 5, table1, v)));
+    ASSERT((same_window.second == batch_exp<G2<ppT>, FieldT>(scalar_size, 5, table2, v)));
+
+    const std::pair<std::vector<G1<ppT> >, std::vector<G2<ppT> > > with_coeff =
+        batch_exp_dual_with_coeff<G1<ppT>, G2<ppT>, FieldT>(scalar_size, 5, table1, 3, table2_narrow, coeff, v);
+    ASSERT((with_coeff.first == batch_exp_with_coeff<G1<ppT>, FieldT>(scalar_size, 5, table1, coeff, v)));
+    ASSERT((with_coeff.second == batch_exp_with_coeff<G2<ppT>, FieldT>(scalar_size, 3, table2_narrow, coeff, v)));
+}
+
 template<typename GroupT>
 void test_output()
 {
@@ -136,35 +461,179 @@ void test_output()
     }
 }
 
+void test_expand_message_xmd()
+{
+    /* RFC 9380, Appendix K.1 */
+    const std::string dst = "QUUX-V01-CS02-with-expander-SHA256-128";
+    const std::vector<std::pair<std::string, std::string> > vectors = {
+        { "", "68a985b87eb6b46952128911f2a4412bbc302a9d759667f87f7a21d803f07235" },
+        { "abc", "d8ccab23b5985ccea865c6c97b6e5b8350e794e603b4b97902f53a8a0d605615" },
+    };
+
+    for (auto &v : vectors)
+    {
+        const std::vector<unsigned char> uniform_bytes = expand_message_xmd(v.first, dst, 32);
+        std::stringstream ss;
+        for (const unsigned char b : uniform_bytes)
+        {
+            ss << std::hex << ((b >> 4) & 0xf) << (b & 0xf);
+        }
+        ASSERT(ss.str() == v.second);
+    }
+
+    ASSERT(expand_message_xmd("abc", dst, 100).size() == 100);
+}
+
+template<typename GroupT, typename FieldT>
+void test_hash_to_curve()
+{
+    const std::string dst = "libff-test-hash-to-curve";
+
+    GroupT a = GroupT::hash_to_curve("abc", dst);
+    ASSERT(a.is_well_formed());
+    ASSERT(!a.is_zero());
+    ASSERT(GroupT::order() * a == GroupT::zero());
+    ASSERT(a == GroupT::hash_to_curve("abc", dst));
+    ASSERT(a != GroupT::hash_to_curve("abd", dst));
+    ASSERT(a != GroupT::hash_to_curve("abc", dst + "'"));
+
+    ASSERT(GroupT::map_to_curve(FieldT::zero()).is_well_formed());
+    ASSERT(GroupT::map_to_curve(FieldT::random_element()).is_well_formed());
+
+    const std::vector<std::string> msgs = { "", "abc", "abcdef0123456789", std::string(200, 'a') };
+    const std::vector<GroupT> batch = GroupT::batch_hash_to_curve(msgs, dst);
+    ASSERT(batch.size() == msgs.size());
+    for (size_t i = 0; i < msgs.size(); ++i)
+    {
+        ASSERT(batch[i] == GroupT::hash_to_curve(msgs[i], dst));
+    }
+}
+
+void test_alt_bn128_G2_subgroup_check()
+{
+    const alt_bn128_G2 a = alt_bn128_G2::random_element();
+    ASSERT(a.is_in_subgroup());
+    ASSERT(alt_bn128_G2::zero().is_in_subgroup());
+
+    /* points produced by the map to the twist are not in G2 until the cofactor is cleared */
+    const alt_bn128_G2 b = alt_bn128_G2::map_to_curve(alt_bn128_Fq2::random_element());
+    ASSERT(b.is_well_formed());
+    ASSERT(!b.is_in_subgroup());
+    ASSERT(alt_bn128_G2::order() * b != alt_bn128_G2::zero());
+    ASSERT(b.clear_cofactor().is_in_subgroup());
+    const bigint<alt_bn128_r_limbs> s = alt_bn128_Fr::random_element().as_bigint();
+    ASSERT(s * b == montgomery_ladder_scalar_mul<alt_bn128_G2>(b, s));
+
+    std::vector<alt_bn128_G2> vec;
+    for (size_t i = 0; i < 10; ++i)
+    {
+        vec.emplace_back(alt_bn128_G2::random_element());
+    }
+    ASSERT(alt_bn128_G2::batch_is_in_subgroup(vec));
+    vec.emplace_back(b);
+    ASSERT(!alt_bn128_G2::batch_is_in_subgroup(vec));
+}
+
+template<typename ppT, typename other_ppT>
+void test_lazy_init()
+{
+    /*
+      the first uses race, including those of another curve that shares
+      fields with this one; all must see fully initialized parameters
+    */
+    std::vector<std::thread> threads;
+    std::vector<G1<ppT> > generators(4);
+    std::vector<G1<other_ppT> > other_generators(4);
+    for (size_t i = 0; i < generators.size(); ++i)
+    {
+        threads.emplace_back([&generators, i]() { generators[i] = G1<ppT>::one(); });
+        threads.emplace_back([&other_generators, i]() { other_generators[i] = G1<other_ppT>::one(); });
+    }
+    for (std::thread &t : threads)
+    {
+        t.join();
+    }
+
+    for (size_t i = 0; i < generators.size(); ++i)
+    {
+        ASSERT(generators[i].is_well_formed());
+        ASSERT(!generators[i].is_zero());
+        ASSERT(generators[i] == G1<ppT>::one());
+        ASSERT(other_generators[i].is_well_formed());
+        ASSERT(other_generators[i] == G1<other_ppT>::one());
+    }
+    ppT::init_public_params();
+    other_ppT::init_public_params();
+    ASSERT(G1<ppT>::one() == generators[0]);
+    ASSERT(G1<other_ppT>::one() == other_generators[0]);
+}
+
 int main(void)
 {
+    test_lazy_init<mnt6_pp, mnt4_pp>();
+
     edwards_pp::init_public_params();
     test_group<G1<edwards_pp> >();
     test_output<G1<edwards_pp> >();
+    test_generator_mul<G1<edwards_pp> >();
+    test_scalar_mul<G1<edwards_pp> >();
+    test_batch_affine<G1<edwards_pp> >();
+    test_extended_edwards<edwards_G1, edwards_G1_extended>();
+    test_multi_exp<G1<edwards_pp> >();
     test_group<G2<edwards_pp> >();
     test_output<G2<edwards_pp> >();
+    test_generator_mul<G2<edwards_pp> >();
+    test_scalar_mul<G2<edwards_pp> >();
+    test_batch_affine<G2<edwards_pp> >();
+    test_extended_edwards<edwards_G2, edwards_G2_extended>();
+    test_multi_exp<G2<edwards_pp> >();
     test_mul_by_q<G2<edwards_pp> >();
 
     mnt4_pp::init_public_params();
     test_group<G1<mnt4_pp> >();
     test_output<G1<mnt4_pp> >();
+    test_generator_mul<G1<mnt4_pp> >();
+    test_scalar_mul<G1<mnt4_pp> >();
+    test_batch_affine<G1<mnt4_pp> >();
     test_group<G2<mnt4_pp> >();
     test_output<G2<mnt4_pp> >();
+    test_generator_mul<G2<mnt4_pp> >();
+    test_scalar_mul<G2<mnt4_pp> >();
+    test_batch_affine<G2<mnt4_pp> >();
     test_mul_by_q<G2<mnt4_pp> >();
+    test_batch_exp_dual<mnt4_pp>();
 
     mnt6_pp::init_public_params();
     test_group<G1<mnt6_pp> >();
     test_output<G1<mnt6_pp> >();
+    test_generator_mul<G1<mnt6_pp> >();
+    test_scalar_mul<G1<mnt6_pp> >();
+    test_batch_affine<G1<mnt6_pp> >();
     test_group<G2<mnt6_pp> >();
     test_output<G2<mnt6_pp> >();
+    test_generator_mul<G2<mnt6_pp> >();
+    test_scalar_mul<G2<mnt6_pp> >();
+    test_batch_affine<G2<mnt6_pp> >();
     test_mul_by_q<G2<mnt6_pp> >();
 
     alt_bn128_pp::init_public_params();
     test_group<G1<alt_bn128_pp> >();
     test_output<G1<alt_bn128_pp> >();
+    test_generator_mul<G1<alt_bn128_pp> >();
+    test_scalar_mul<G1<alt_bn128_pp> >();
+    test_batch_affine<G1<alt_bn128_pp> >();
+    test_multi_exp<G1<alt_bn128_pp> >();
     test_group<G2<alt_bn128_pp> >();
     test_output<G2<alt_bn128_pp> >();
+    test_generator_mul<G2<alt_bn128_pp> >();
+    test_scalar_mul<G2<alt_bn128_pp> >();
+    test_batch_affine<G2<alt_bn128_pp> >();
     test_mul_by_q<G2<alt_bn128_pp> >();
+    test_batch_exp_dual<alt_bn128_pp>();
+    test_expand_message_xmd();
+    test_hash_to_curve<G1<alt_bn128_pp>, alt_bn128_Fq>();
+    test_hash_to_curve<G2<alt_bn128_pp>, alt_bn128_Fq2>();
+    test_alt_bn128_G2_subgroup_check();
 
 #ifdef CURVE_BN128       // BN128 has fancy dependencies so it may be disabled
     bn128_pp::init_public_params();
@@ -1,7 +1,7 @@
 /** @file
  *****************************************************************************
 
- Declaration of interfaces for (square-and-multiply) exponentiation.
+ Declaration of interfaces for (sliding-window) exponentiation.
 
  *****************************************************************************
  * @author     This file is part of libff, developed by SCIPR Lab
@@ -13,17 +13,47 @@
 #define EXPONENTIATION_HPP_
 
 #include <cstdint>
+#include <vector>
 
 #include <libff/algebra/fields/bigint.hpp>
 
 namespace libff {
 
+/**
+ * An exponent recoded into sliding-window form.
+ *
+ * The exponent equals \sum_i digits[i] * 2^i, where every digit is either zero
+ * or odd and smaller than 2^window_size. Exponents that are used over and over
+ * (e.g., the fixed exponents in square root computations) should be recoded
+ * once and kept in this form.
+ */
+class sliding_window_exponent {
+public:
+    size_t window_size;
+    std::vector<size_t> digits;
+
+    sliding_window_exponent() : window_size(1) {}
+    template<mp_size_t m>
+    explicit sliding_window_exponent(const bigint<m> &exponent);
+    template<mp_size_t m>
+    sliding_window_exponent(const bigint<m> &exponent, const size_t window_size);
+};
+
+/**
+ * Compute the window size that minimizes the expected number of
+ * multiplications for an exponent of the given bit length.
+ */
+inline size_t get_power_window_size(const size_t exponent_bits);
+
 template<typename FieldT, mp_size_t m>
 FieldT power(const FieldT &base, const bigint<m> &exponent);
 
 template<typename FieldT>
 FieldT power(const FieldT &base, const unsigned long exponent);
 
+template<typename FieldT>
+FieldT power(const FieldT &base, const sliding_window_exponent &exponent);
+
 } // libff
 
 #include <libff/algebra/exponentiation/exponentiation.tcc>
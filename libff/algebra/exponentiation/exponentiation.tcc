@@ -1,7 +1,7 @@
 /** @file
  *****************************************************************************
 
- Implementation of interfaces for (square-and-multiply) exponentiation.
+ Implementation of interfaces for (sliding-window) exponentiation.
 
  See exponentiation.hpp .
 
@@ -14,34 +14,145 @@
 #ifndef EXPONENTIATION_TCC_
 #define EXPONENTIATION_TCC_
 
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+
+#include <libff/common/template_utils.hpp>
 #include <libff/common/utils.hpp>
 
 namespace libff {
 
-template<typename FieldT, mp_size_t m>
-FieldT power(const FieldT &base, const bigint<m> &exponent)
+/* Use the dedicated squaring routine of FieldT if it has one (e.g., bn128_GT does not). */
+template<typename FieldT, typename = void>
+struct power_squaring
 {
-    FieldT result = FieldT::one();
+    static FieldT square(const FieldT &el) { return el * el; }
+};
 
-    bool found_one = false;
+template<typename FieldT>
+struct power_squaring<FieldT, typename void_type<decltype(std::declval<const FieldT&>().squared())>::type>
+{
+    static FieldT square(const FieldT &el) { return el.squared(); }
+};
 
-    for (long i = static_cast<long>(exponent.max_bits() - 1); i >= 0; --i)
+inline size_t get_power_window_size(const size_t exponent_bits)
+{
+    /*
+      A window of w bits costs 2^(w-1) multiplications to precompute the odd
+      powers, and about exponent_bits/(w+1) multiplications in the main loop.
+    */
+    size_t best = 1;
+    double best_cost = 1 + exponent_bits / 2.;
+    for (size_t w = 2; w < 8; ++w)
     {
-        if (found_one)
+        const double cost = (1ul << (w-1)) + exponent_bits / (w + 1.);
+        if (cost < best_cost)
         {
-            result = result * result;
+            best = w;
+            best_cost = cost;
         }
+    }
+
+    return best;
+}
+
+template<mp_size_t m>
+sliding_window_exponent::sliding_window_exponent(const bigint<m> &exponent) :
+    sliding_window_exponent(exponent, get_power_window_size(exponent.num_bits()))
+{
+}
 
-        if (exponent.test_bit(static_cast<size_t>(i)))
+template<mp_size_t m>
+sliding_window_exponent::sliding_window_exponent(const bigint<m> &exponent, const size_t window_size) :
+    window_size(window_size)
+{
+    const long length = static_cast<long>(exponent.num_bits());
+    digits.assign(length, 0);
+
+    long i = length - 1;
+    while (i >= 0)
+    {
+        if (!exponent.test_bit(static_cast<size_t>(i)))
+        {
+            --i;
+            continue;
+        }
+
+        /* the window [j, i] is as wide as possible, and starts and ends with a one */
+        long j = std::max(i - static_cast<long>(window_size) + 1, 0l);
+        while (!exponent.test_bit(static_cast<size_t>(j)))
         {
-            found_one = true;
-            result = result * base;
+            ++j;
+        }
+
+        size_t digit = 0;
+        for (long k = i; k >= j; --k)
+        {
+            digit = (digit << 1) | (exponent.test_bit(static_cast<size_t>(k)) ? 1 : 0);
+        }
+
+        digits[static_cast<size_t>(j)] = digit;
+        i = j - 1;
+    }
+}
+
+template<typename FieldT>
+FieldT power(const FieldT &base, const sliding_window_exponent &exponent)
+{
+    if (exponent.digits.empty())
+    {
+        return FieldT::one();
+    }
+
+    /* table[i] = base^(2*i+1) */
+    const size_t table_size = 1ul << (exponent.window_size - 1);
+    std::vector<FieldT> table;
+    table.reserve(table_size);
+    table.emplace_back(base);
+    if (table_size > 1)
+    {
+        const FieldT base_squared = power_squaring<FieldT>::square(base);
+        for (size_t i = 1; i < table_size; ++i)
+        {
+            table.emplace_back(table[i-1] * base_squared);
+        }
+    }
+
+    FieldT result = FieldT::one();
+    bool found_nonzero = false;
+
+    for (long i = static_cast<long>(exponent.digits.size() - 1); i >= 0; --i)
+    {
+        if (found_nonzero)
+        {
+            result = power_squaring<FieldT>::square(result);
+        }
+
+        const size_t digit = exponent.digits[static_cast<size_t>(i)];
+        if (digit != 0)
+        {
+            if (found_nonzero)
+            {
+                result = result * table[digit/2];
+            }
+            else
+            {
+                result = table[digit/2];
+                found_nonzero = true;
+            }
         }
     }
 
     return result;
 }
 
+template<typename FieldT, mp_size_t m>
+FieldT power(const FieldT &base, const bigint<m> &exponent)
+{
+    return power<FieldT>(base, sliding_window_exponent(exponent));
+}
+
 template<typename FieldT>
 FieldT power(const FieldT &base, const unsigned long exponent)
 {
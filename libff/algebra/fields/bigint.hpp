@@ -58,6 +58,13 @@ public:
     friend std::istream& operator>> <n>(std::istream &in, bigint<n> &b);
 };
 
+/**
+ * Computes the Jacobi symbol (a/m) for odd m, using a binary-GCD-style
+ * algorithm that only shifts and subtracts the fixed-size limbs.
+ */
+template<mp_size_t n>
+int jacobi_symbol(const bigint<n> &a, const bigint<n> &m);
+
 } // libff
 #include <libff/algebra/fields/bigint.tcc>
 #endif
@@ -11,6 +11,7 @@
 #define BIGINT_TCC_
 #include <cstring>
 #include <random>
+#include <utility>
 
 #include <libff/common/assert.hpp>
 
@@ -223,5 +224,52 @@ std::istream& operator>>(std::istream &in, bigint<n> &b)
     return in;
 }
 
+template<mp_size_t n>
+int jacobi_symbol(const bigint<n> &a, const bigint<n> &m)
+{
+    ASSERT((m.data[0] & 1) == 1);
+
+    bigint<n> x = a;
+    bigint<n> y = m;
+    int result = 1;
+
+    while (!x.is_zero())
+    {
+        /* strip factors of two, using (2/y) = -1 iff y = 3, 5 (mod 8) */
+        const size_t zeros = mpn_scan1(x.data, 0);
+        const mp_size_t limb_shift = zeros / GMP_NUMB_BITS;
+        const unsigned bit_shift = zeros % GMP_NUMB_BITS;
+        if (limb_shift > 0)
+        {
+            mpn_copyi(x.data, x.data + limb_shift, n - limb_shift);
+            mpn_zero(x.data + n - limb_shift, limb_shift);
+        }
+        if (bit_shift > 0)
+        {
+            mpn_rshift(x.data, x.data, n, bit_shift);
+        }
+
+        const mp_limb_t y_mod_8 = y.data[0] & 7;
+        if ((zeros & 1) == 1 && (y_mod_8 == 3 || y_mod_8 == 5))
+        {
+            result = -result;
+        }
+
+        /* now both are odd; use quadratic reciprocity to keep x >= y */
+        if (mpn_cmp(x.data, y.data, n) < 0)
+        {
+            std::swap(x, y);
+            if ((x.data[0] & 3) == 3 && (y.data[0] & 3) == 3)
+            {
+                result = -result;
+            }
+        }
+
+        mpn_sub_n(x.data, x.data, y.data, n);
+    }
+
+    return (y == bigint<n>(1ul) ? result : 0);
+}
+
 } // libff
 #endif // BIGINT_TCC_
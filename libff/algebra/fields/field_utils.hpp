@@ -11,6 +11,7 @@
 
 #include <libff/algebra/fields/bigint.hpp>
 #include <libff/common/double.hpp>
+#include <libff/common/packed_bit_vector.hpp>
 #include <libff/common/utils.hpp>
 
 namespace libff {
@@ -24,9 +25,31 @@ template<typename FieldT>
 typename std::enable_if<!std::is_same<FieldT, Double>::value, FieldT>::type
 get_root_of_unity(const size_t n);
 
+/**
+ * The packing and conversion functions below move bits a limb at a time
+ * through packed_bit_vector. The bit_vector overloads convert their argument
+ * or result with one pass over the bits.
+ */
+
+/* w <= 64 */
 template<typename FieldT>
 std::vector<FieldT> pack_int_vector_into_field_element_vector(const std::vector<size_t> &v, const size_t w);
 
+template<typename FieldT>
+std::vector<FieldT> pack_bit_vector_into_field_element_vector(const packed_bit_vector &v, const size_t chunk_bits);
+
+template<typename FieldT>
+std::vector<FieldT> pack_bit_vector_into_field_element_vector(const packed_bit_vector &v);
+
+template<typename FieldT>
+packed_bit_vector convert_field_element_vector_to_packed_bit_vector(const std::vector<FieldT> &v);
+
+template<typename FieldT>
+packed_bit_vector convert_field_element_to_packed_bit_vector(const FieldT &el);
+
+template<typename FieldT>
+FieldT convert_packed_bit_vector_to_field_element(const packed_bit_vector &v);
+
 template<typename FieldT>
 std::vector<FieldT> pack_bit_vector_into_field_element_vector(const bit_vector &v, const size_t chunk_bits);
 
@@ -51,6 +74,24 @@ FieldT convert_bit_vector_to_field_element(const bit_vector &v);
 template<typename FieldT>
 void batch_invert(std::vector<FieldT> &vec);
 
+/**
+ * Invert the non-zero elements of vec in place, leaving zeros as they are.
+ * Under MULTICORE the vector is split into one chunk per thread, each
+ * sharing a single inversion.
+ */
+template<typename FieldT>
+void batch_invert_nonzeros(std::vector<FieldT> &vec);
+
+/**
+ * Square root by Tonelli--Shanks, using per-field data that is precomputed on
+ * first use: the recoded exponent (t-1)/2 and the powers nqr_to_t^(2^i), so
+ * the loop over s needs no squarings of the root of unity. For s = 1 this is
+ * a single exponentiation by (p+1)/4.
+ * el HAS TO BE A SQUARE (else does not terminate).
+ */
+template<typename FieldT>
+FieldT tonelli_shanks_sqrt(const FieldT &el);
+
 } // libff
 #include <libff/algebra/fields/field_utils.tcc>
 
@@ -10,9 +10,15 @@
 #ifndef FIELD_UTILS_TCC_
 #define FIELD_UTILS_TCC_
 
+#include <algorithm>
 #include <complex>
 #include <stdexcept>
 
+#ifdef MULTICORE
+#include <omp.h>
+#endif
+
+#include <libff/algebra/exponentiation/exponentiation.hpp>
 #include <libff/common/double.hpp>
 #include <libff/common/utils.hpp>
 
@@ -50,58 +56,80 @@ get_root_of_unity(const size_t n)
     return omega;
 }
 
+/* bits [pos, pos+count) of v, a limb at a time */
+template<mp_size_t n>
+bigint<n> packed_bits_to_bigint(const packed_bit_vector &v, const size_t pos, const size_t count)
+{
+    bigint<n> b;
+    for (size_t k = 0; k * GMP_NUMB_BITS < count; ++k)
+    {
+        b.data[k] = v.get_bits(pos + k * GMP_NUMB_BITS, std::min<size_t>(GMP_NUMB_BITS, count - k * GMP_NUMB_BITS));
+    }
+    return b;
+}
+
+/* appends the low count bits of b, a limb at a time */
+template<mp_size_t n>
+void append_bigint_bits(packed_bit_vector &v, const bigint<n> &b, const size_t count)
+{
+    for (size_t k = 0; k * GMP_NUMB_BITS < count; ++k)
+    {
+        v.append_bits(b.data[k], std::min<size_t>(GMP_NUMB_BITS, count - k * GMP_NUMB_BITS));
+    }
+}
+
 template<typename FieldT>
 std::vector<FieldT> pack_int_vector_into_field_element_vector(const std::vector<size_t> &v, const size_t w)
 {
-    const size_t chunk_bits = FieldT::capacity();
-    const size_t repacked_size = div_ceil(v.size() * w, chunk_bits);
-    std::vector<FieldT> result(repacked_size);
+    ASSERT(w <= packed_bit_vector::word_bits);
 
-    for (size_t i = 0; i < repacked_size; ++i)
+    packed_bit_vector bits;
+    bits.reserve(v.size() * w);
+    for (const size_t word : v)
     {
-        bigint<FieldT::num_limbs> b;
-        for (size_t j = 0; j < chunk_bits; ++j)
-        {
-            const size_t word_index = (i * chunk_bits + j) / w;
-            const size_t pos_in_word = (i * chunk_bits + j) % w;
-            const size_t word_or_0 = (word_index < v.size() ? v[word_index] : 0);
-            const size_t bit = (word_or_0 >> pos_in_word) & 1;
-
-            b.data[j / GMP_NUMB_BITS] |= bit << (j % GMP_NUMB_BITS);
-        }
-        result[i] = FieldT(b);
+        bits.append_bits(word, w);
     }
 
-    return result;
+    return pack_bit_vector_into_field_element_vector<FieldT>(bits, FieldT::capacity());
 }
 
 template<typename FieldT>
-std::vector<FieldT> pack_bit_vector_into_field_element_vector(const bit_vector &v, const size_t chunk_bits)
+std::vector<FieldT> pack_bit_vector_into_field_element_vector(const packed_bit_vector &v, const size_t chunk_bits)
 {
     ASSERT(chunk_bits <= FieldT::capacity());
 
     const size_t repacked_size = div_ceil(v.size(), chunk_bits);
     std::vector<FieldT> result(repacked_size);
 
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
     for (size_t i = 0; i < repacked_size; ++i)
     {
-        bigint<FieldT::num_limbs> b;
-        for (size_t j = 0; j < chunk_bits; ++j)
-        {
-            b.data[j / GMP_NUMB_BITS] |= ((i * chunk_bits + j) < v.size() && v[i * chunk_bits + j] ? 1ll : 0ll) << (j % GMP_NUMB_BITS);
-        }
-        result[i] = FieldT(b);
+        result[i] = FieldT(packed_bits_to_bigint<FieldT::num_limbs>(v, i * chunk_bits, chunk_bits));
     }
 
     return result;
 }
 
 template<typename FieldT>
-std::vector<FieldT> pack_bit_vector_into_field_element_vector(const bit_vector &v)
+std::vector<FieldT> pack_bit_vector_into_field_element_vector(const packed_bit_vector &v)
 {
     return pack_bit_vector_into_field_element_vector<FieldT>(v, FieldT::capacity());
 }
 
+template<typename FieldT>
+std::vector<FieldT> pack_bit_vector_into_field_element_vector(const bit_vector &v, const size_t chunk_bits)
+{
+    return pack_bit_vector_into_field_element_vector<FieldT>(packed_bit_vector(v), chunk_bits);
+}
+
+template<typename FieldT>
+std::vector<FieldT> pack_bit_vector_into_field_element_vector(const bit_vector &v)
+{
+    return pack_bit_vector_into_field_element_vector<FieldT>(packed_bit_vector(v), FieldT::capacity());
+}
+
 template<typename FieldT>
 std::vector<FieldT> convert_bit_vector_to_field_element_vector(const bit_vector &v)
 {
@@ -117,33 +145,39 @@ std::vector<FieldT> convert_bit_vector_to_field_element_vector(const bit_vector
 }
 
 template<typename FieldT>
-bit_vector convert_field_element_vector_to_bit_vector(const std::vector<FieldT> &v)
+packed_bit_vector convert_field_element_vector_to_packed_bit_vector(const std::vector<FieldT> &v)
 {
-    bit_vector result;
+    packed_bit_vector result;
+    result.reserve(v.size() * FieldT::size_in_bits());
 
     for (const FieldT &el : v)
     {
-        const bit_vector el_bits = convert_field_element_to_bit_vector<FieldT>(el);
-        result.insert(result.end(), el_bits.begin(), el_bits.end());
+        append_bigint_bits(result, el.as_bigint(), FieldT::size_in_bits());
     }
 
     return result;
 }
 
 template<typename FieldT>
-bit_vector convert_field_element_to_bit_vector(const FieldT &el)
+bit_vector convert_field_element_vector_to_bit_vector(const std::vector<FieldT> &v)
 {
-    bit_vector result;
-
-    bigint<FieldT::num_limbs> b = el.as_bigint();
-    for (size_t i = 0; i < FieldT::size_in_bits(); ++i)
-    {
-        result.push_back(b.test_bit(i));
-    }
+    return convert_field_element_vector_to_packed_bit_vector(v).to_bit_vector();
+}
 
+template<typename FieldT>
+packed_bit_vector convert_field_element_to_packed_bit_vector(const FieldT &el)
+{
+    packed_bit_vector result;
+    append_bigint_bits(result, el.as_bigint(), FieldT::size_in_bits());
     return result;
 }
 
+template<typename FieldT>
+bit_vector convert_field_element_to_bit_vector(const FieldT &el)
+{
+    return convert_field_element_to_packed_bit_vector(el).to_bit_vector();
+}
+
 template<typename FieldT>
 bit_vector convert_field_element_to_bit_vector(const FieldT &el, const size_t bitcount)
 {
@@ -154,18 +188,23 @@ bit_vector convert_field_element_to_bit_vector(const FieldT &el, const size_t bi
 }
 
 template<typename FieldT>
-FieldT convert_bit_vector_to_field_element(const bit_vector &v)
+FieldT convert_packed_bit_vector_to_field_element(const packed_bit_vector &v)
 {
     ASSERT(v.size() <= FieldT::size_in_bits());
 
-    FieldT res = FieldT::zero();
-    FieldT c = FieldT::one();
-    for (bool b : v)
+    /* below 2^size_in_bits <= 2p, so one subtraction reduces it */
+    bigint<FieldT::num_limbs> b = packed_bits_to_bigint<FieldT::num_limbs>(v, 0, v.size());
+    if (mpn_cmp(b.data, FieldT::mod.data, FieldT::num_limbs) >= 0)
     {
-        res += b ? c : FieldT::zero();
-        c += c;
+        mpn_sub_n(b.data, b.data, FieldT::mod.data, FieldT::num_limbs);
     }
-    return res;
+    return FieldT(b);
+}
+
+template<typename FieldT>
+FieldT convert_bit_vector_to_field_element(const bit_vector &v)
+{
+    return convert_packed_bit_vector_to_field_element<FieldT>(packed_bit_vector(v));
 }
 
 template<typename FieldT>
@@ -193,5 +232,134 @@ void batch_invert(std::vector<FieldT> &vec)
     }
 }
 
+template<typename FieldT>
+void batch_invert_nonzeros(std::vector<FieldT> &vec)
+{
+    if (vec.empty())
+    {
+        return;
+    }
+
+#ifdef MULTICORE
+    const size_t num_chunks = std::min(static_cast<size_t>(omp_get_max_threads()), vec.size());
+#else
+    const size_t num_chunks = 1;
+#endif
+    const size_t chunk_size = (vec.size() + num_chunks - 1) / num_chunks;
+
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+    for (size_t c = 0; c < num_chunks; ++c)
+    {
+        const size_t begin = c * chunk_size;
+        const size_t end = std::min(begin + chunk_size, vec.size());
+        if (begin >= end)
+        {
+            continue;
+        }
+
+        std::vector<FieldT> prod;
+        prod.reserve(end - begin);
+
+        FieldT acc = FieldT::one();
+        for (size_t i = begin; i < end; ++i)
+        {
+            prod.emplace_back(acc);
+            if (!vec[i].is_zero())
+            {
+                acc = acc * vec[i];
+            }
+        }
+
+        FieldT acc_inverse = acc.inverse();
+
+        for (size_t i = end; i-- > begin; )
+        {
+            if (!vec[i].is_zero())
+            {
+                const FieldT old_el = vec[i];
+                vec[i] = acc_inverse * prod[i - begin];
+                acc_inverse = acc_inverse * old_el;
+            }
+        }
+    }
+}
+
+template<typename FieldT>
+class tonelli_shanks_table {
+public:
+    sliding_window_exponent t_minus_1_over_2;
+    std::vector<FieldT> nqr_to_t_powers; // nqr_to_t^(2^i) for i = 0, ..., s-1
+
+    tonelli_shanks_table() : t_minus_1_over_2(FieldT::t_minus_1_over_2)
+    {
+        nqr_to_t_powers.reserve(FieldT::s);
+        FieldT z = FieldT::nqr_to_t;
+        for (size_t i = 0; i < FieldT::s; ++i)
+        {
+            nqr_to_t_powers.emplace_back(z);
+            z = z.squared();
+        }
+    }
+};
+
+template<typename FieldT>
+FieldT tonelli_shanks_sqrt(const FieldT &el)
+{
+    static const tonelli_shanks_table<FieldT> table;
+
+    if (el.is_zero())
+    {
+        return el;
+    }
+
+    const FieldT one = FieldT::one();
+    const FieldT w = power<FieldT>(el, table.t_minus_1_over_2);
+    FieldT x = el * w;
+
+    FieldT b = x * w; // b = el^t
+
+#if DEBUG
+    // check if square with euler's criterion
+    FieldT check = b;
+    for (size_t i = 0; i < FieldT::s-1; ++i)
+    {
+        check = check.squared();
+    }
+    if (check != one)
+    {
+        ASSERT(0);
+    }
+#endif
+
+    if (FieldT::s == 1)
+    {
+        return x; // x = el^((p+1)/4)
+    }
+
+    /*
+      Invariant: b has order 2^m for some m < v, and the current z (the
+      generator of the 2^v-subgroup) equals nqr_to_t^(2^(s-v)). So the usual
+      w = z^(2^(v-m-1)) is nqr_to_t^(2^(s-m-1)), which is in the table.
+    */
+    while (b != one)
+    {
+        size_t m = 0;
+        FieldT b2m = b;
+        while (b2m != one)
+        {
+            /* invariant: b2m = b^(2^m) after entering this loop */
+            b2m = b2m.squared();
+            m += 1;
+        }
+
+        x = x * table.nqr_to_t_powers[FieldT::s-m-1];
+        b = b * table.nqr_to_t_powers[FieldT::s-m];
+    }
+
+    return x;
+}
+
 } // libff
 #endif // FIELD_UTILS_TCC_
@@ -0,0 +1,120 @@
+/** @file
+ *****************************************************************************
+
+ Declaration of element-wise operations on vectors of field elements.
+
+ All kernels walk their inputs in blocks of field_vector_block_size
+ elements, and under MULTICORE the blocks are split across threads. The
+ output vector may be the same object as any of the inputs; the *_in_place
+ variants avoid the extra argument altogether. Output vectors are resized as
+ needed, so passing the same vector to repeated calls reuses its storage.
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef FIELD_VECTOR_OPS_HPP_
+#define FIELD_VECTOR_OPS_HPP_
+
+#include <cstdint>
+#include <vector>
+
+#include <libff/algebra/fields/bigint.hpp>
+
+namespace libff {
+
+/* elements per block; small enough that a block of each operand stays in L1 */
+const size_t field_vector_block_size = 256;
+
+/* out[i] = a[i] + b[i] */
+template<typename FieldT>
+void vector_add(std::vector<FieldT> &out, const std::vector<FieldT> &a, const std::vector<FieldT> &b);
+
+/* a[i] += b[i] */
+template<typename FieldT>
+void vector_add_in_place(std::vector<FieldT> &a, const std::vector<FieldT> &b);
+
+/* out[i] = a[i] - b[i] */
+template<typename FieldT>
+void vector_sub(std::vector<FieldT> &out, const std::vector<FieldT> &a, const std::vector<FieldT> &b);
+
+/* a[i] -= b[i] */
+template<typename FieldT>
+void vector_sub_in_place(std::vector<FieldT> &a, const std::vector<FieldT> &b);
+
+/* out[i] = a[i] * b[i]; uses squaring when a and b are the same vector */
+template<typename FieldT>
+void vector_mul(std::vector<FieldT> &out, const std::vector<FieldT> &a, const std::vector<FieldT> &b);
+
+/* a[i] *= b[i] */
+template<typename FieldT>
+void vector_mul_in_place(std::vector<FieldT> &a, const std::vector<FieldT> &b);
+
+/* out[i] = a[i]^2 */
+template<typename FieldT>
+void vector_square(std::vector<FieldT> &out, const std::vector<FieldT> &a);
+
+/* a[i] = a[i]^2 */
+template<typename FieldT>
+void vector_square_in_place(std::vector<FieldT> &a);
+
+/* out[i] = c * a[i] */
+template<typename FieldT>
+void vector_scale(std::vector<FieldT> &out, const std::vector<FieldT> &a, const FieldT &c);
+
+/* a[i] *= c */
+template<typename FieldT>
+void vector_scale_in_place(std::vector<FieldT> &a, const FieldT &c);
+
+/* y[i] += alpha * x[i] */
+template<typename FieldT>
+void vector_axpy(std::vector<FieldT> &y, const FieldT &alpha, const std::vector<FieldT> &x);
+
+/**
+ * \sum_i a[i] * b[i]. Under MULTICORE the sum is split into one part per
+ * thread. For prime fields, each part adds up the double-width products of
+ * the Montgomery representations without reducing them and reduces once at
+ * the end, instead of once per term.
+ */
+template<typename FieldT>
+FieldT vector_inner_product(const std::vector<FieldT> &a, const std::vector<FieldT> &b);
+
+/* out[j] = vector_inner_product(a, bs[j]), in one pass over a */
+template<typename FieldT>
+void vector_inner_products(std::vector<FieldT> &out, const std::vector<FieldT> &a, const std::vector<std::vector<FieldT> > &bs);
+
+/**
+ * out = (start, start * ratio, start * ratio^2, ..., start * ratio^(size-1)),
+ * e.g. the powers of tau for start = 1. Each block starts from
+ * start * ratio^begin, so blocks are independent.
+ */
+template<typename FieldT>
+void geometric_sequence(std::vector<FieldT> &out, const FieldT &start, const FieldT &ratio, const size_t size);
+
+template<typename FieldT>
+std::vector<FieldT> geometric_sequence(const FieldT &start, const FieldT &ratio, const size_t size);
+
+/**
+ * out[i] = a[i].as_bigint(), the canonical (not Montgomery) representations.
+ * For prime fields this goes through Fp_batch when its fastest backend beats
+ * Fp_model::as_bigint (i.e., with AVX-512 IFMA).
+ */
+template<typename FieldT>
+void vector_as_bigints(std::vector<bigint<FieldT::num_limbs> > &out, const std::vector<FieldT> &a);
+
+template<typename FieldT>
+void vector_as_bigints(std::vector<bigint<FieldT::num_limbs> > &out,
+                       typename std::vector<FieldT>::const_iterator begin,
+                       typename std::vector<FieldT>::const_iterator end);
+
+/* out[i] = FieldT(a[i]), converting canonical representations to Montgomery form */
+template<typename FieldT>
+void vector_from_bigints(std::vector<FieldT> &out, const std::vector<bigint<FieldT::num_limbs> > &a);
+
+} // libff
+
+#include <libff/algebra/fields/field_vector_ops.tcc>
+
+#endif // FIELD_VECTOR_OPS_HPP_
@@ -0,0 +1,428 @@
+/** @file
+ *****************************************************************************
+
+ Implementation of element-wise operations on vectors of field elements.
+
+ See field_vector_ops.hpp .
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef FIELD_VECTOR_OPS_TCC_
+#define FIELD_VECTOR_OPS_TCC_
+
+#include <algorithm>
+
+#ifdef MULTICORE
+#include <omp.h>
+#endif
+
+#include <libff/algebra/exponentiation/exponentiation.hpp>
+#include <libff/algebra/fields/fp_batch.hpp>
+#include <libff/common/utils.hpp>
+
+namespace libff {
+
+/* Calls f(begin, end) for every block of [0, size), in parallel under MULTICORE. */
+template<typename F>
+void for_each_field_vector_block(const size_t size, const F &f)
+{
+    const size_t num_blocks = (size + field_vector_block_size - 1) / field_vector_block_size;
+
+#ifdef MULTICORE
+#pragma omp parallel for schedule(static)
+#endif
+    for (size_t blk = 0; blk < num_blocks; ++blk)
+    {
+        const size_t begin = blk * field_vector_block_size;
+        const size_t end = std::min(begin + field_vector_block_size, size);
+        f(begin, end);
+    }
+}
+
+template<typename FieldT>
+void vector_add(std::vector<FieldT> &out, const std::vector<FieldT> &a, const std::vector<FieldT> &b)
+{
+    ASSERT(a.size() == b.size());
+    out.resize(a.size());
+
+    for_each_field_vector_block(a.size(), [&](const size_t begin, const size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            out[i] = a[i] + b[i];
+        }
+    });
+}
+
+template<typename FieldT>
+void vector_add_in_place(std::vector<FieldT> &a, const std::vector<FieldT> &b)
+{
+    ASSERT(a.size() == b.size());
+
+    for_each_field_vector_block(a.size(), [&](const size_t begin, const size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            a[i] += b[i];
+        }
+    });
+}
+
+template<typename FieldT>
+void vector_sub(std::vector<FieldT> &out, const std::vector<FieldT> &a, const std::vector<FieldT> &b)
+{
+    ASSERT(a.size() == b.size());
+    out.resize(a.size());
+
+    for_each_field_vector_block(a.size(), [&](const size_t begin, const size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            out[i] = a[i] - b[i];
+        }
+    });
+}
+
+template<typename FieldT>
+void vector_sub_in_place(std::vector<FieldT> &a, const std::vector<FieldT> &b)
+{
+    ASSERT(a.size() == b.size());
+
+    for_each_field_vector_block(a.size(), [&](const size_t begin, const size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            a[i] -= b[i];
+        }
+    });
+}
+
+template<typename FieldT>
+void vector_mul(std::vector<FieldT> &out, const std::vector<FieldT> &a, const std::vector<FieldT> &b)
+{
+    if (&a == &b)
+    {
+        vector_square(out, a);
+        return;
+    }
+
+    ASSERT(a.size() == b.size());
+    out.resize(a.size());
+
+    for_each_field_vector_block(a.size(), [&](const size_t begin, const size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            out[i] = a[i] * b[i];
+        }
+    });
+}
+
+template<typename FieldT>
+void vector_mul_in_place(std::vector<FieldT> &a, const std::vector<FieldT> &b)
+{
+    if (&a == &b)
+    {
+        vector_square_in_place(a);
+        return;
+    }
+
+    ASSERT(a.size() == b.size());
+
+    for_each_field_vector_block(a.size(), [&](const size_t begin, const size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            a[i] *= b[i];
+        }
+    });
+}
+
+template<typename FieldT>
+void vector_square(std::vector<FieldT> &out, const std::vector<FieldT> &a)
+{
+    out.resize(a.size());
+
+    for_each_field_vector_block(a.size(), [&](const size_t begin, const size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            out[i] = a[i].squared();
+        }
+    });
+}
+
+template<typename FieldT>
+void vector_square_in_place(std::vector<FieldT> &a)
+{
+    for_each_field_vector_block(a.size(), [&](const size_t begin, const size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            a[i] = a[i].squared();
+        }
+    });
+}
+
+template<typename FieldT>
+void vector_scale(std::vector<FieldT> &out, const std::vector<FieldT> &a, const FieldT &c)
+{
+    const FieldT c_copy = c; // c may live in out
+    out.resize(a.size());
+
+    for_each_field_vector_block(a.size(), [&](const size_t begin, const size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            out[i] = c_copy * a[i];
+        }
+    });
+}
+
+template<typename FieldT>
+void vector_scale_in_place(std::vector<FieldT> &a, const FieldT &c)
+{
+    const FieldT c_copy = c; // c may live in a
+    for_each_field_vector_block(a.size(), [&](const size_t begin, const size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            a[i] *= c_copy;
+        }
+    });
+}
+
+template<typename FieldT>
+void vector_axpy(std::vector<FieldT> &y, const FieldT &alpha, const std::vector<FieldT> &x)
+{
+    ASSERT(x.size() == y.size());
+    const FieldT alpha_copy = alpha; // alpha may live in y
+
+    for_each_field_vector_block(y.size(), [&](const size_t begin, const size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            y[i] += alpha_copy * x[i];
+        }
+    });
+}
+
+/* Computes the inner products of a with each of the vectors bs, over [begin, end). */
+template<typename FieldT>
+struct field_vector_dot {
+    static void compute(std::vector<FieldT> &out, const FieldT *a, const std::vector<const FieldT*> &bs,
+                        const size_t begin, const size_t end)
+    {
+        out.assign(bs.size(), FieldT::zero());
+
+        for (size_t blk = begin; blk < end; blk += field_vector_block_size)
+        {
+            const size_t blk_end = std::min(blk + field_vector_block_size, end);
+            for (size_t j = 0; j < bs.size(); ++j)
+            {
+                for (size_t i = blk; i < blk_end; ++i)
+                {
+                    out[j] = out[j] + a[i] * bs[j][i];
+                }
+            }
+        }
+    }
+};
+
+template<mp_size_t n, const bigint<n>& modulus>
+struct field_vector_dot<Fp_model<n, modulus> > {
+    typedef Fp_model<n, modulus> FieldT;
+
+    /* an unreduced sum of products, 2n limbs and a carry limb */
+    static const size_t width = 2 * n + 1;
+
+    static void compute(std::vector<FieldT> &out, const FieldT *a, const std::vector<const FieldT*> &bs,
+                        const size_t begin, const size_t end)
+    {
+        std::vector<mp_limb_t> sums(bs.size() * width, 0);
+        mp_limb_t prod[2 * n];
+
+        for (size_t blk = begin; blk < end; blk += field_vector_block_size)
+        {
+            const size_t blk_end = std::min(blk + field_vector_block_size, end);
+            for (size_t j = 0; j < bs.size(); ++j)
+            {
+                mp_limb_t *sum = &sums[j * width];
+                for (size_t i = blk; i < blk_end; ++i)
+                {
+                    /* each product is below p^2 < 2^(128n), so the carry limb overflows only after 2^64 terms */
+                    mpn_mul_n(prod, a[i].mont_repr.data, bs[j][i].mont_repr.data, n);
+                    sum[2 * n] += mpn_add_n(sum, sum, prod, 2 * n);
+                }
+            }
+        }
+
+        out.resize(bs.size());
+        for (size_t j = 0; j < bs.size(); ++j)
+        {
+            out[j] = reduce(&sums[j * width]);
+        }
+    }
+
+    /**
+     * The sum of the products (a R) (b R) is (\sum ab) R^2 mod p; one
+     * Montgomery reduction of it leaves the Montgomery form (\sum ab) R.
+     */
+    static FieldT reduce(const mp_limb_t *sum)
+    {
+        mp_limb_t quotient[width - n + 1];
+        FieldT result;
+        mpn_tdiv_qr(quotient, result.mont_repr.data, 0, sum, width, modulus.data, n);
+        result.mul_reduce(bigint<n>(1));
+        return result;
+    }
+};
+
+/* out[j] = \sum_{i < size} a[i] * bs[j][i], with one part per thread under MULTICORE */
+template<typename FieldT>
+void field_vector_inner_products(std::vector<FieldT> &out, const FieldT *a,
+                                 const std::vector<const FieldT*> &bs, const size_t size)
+{
+#ifdef MULTICORE
+    const size_t num_parts = std::max<size_t>(1, std::min(static_cast<size_t>(omp_get_max_threads()),
+                                                          size / field_vector_block_size));
+#else
+    const size_t num_parts = 1;
+#endif
+    const size_t part_size = (size + num_parts - 1) / num_parts;
+
+    std::vector<std::vector<FieldT> > partial(num_parts);
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+    for (size_t c = 0; c < num_parts; ++c)
+    {
+        const size_t begin = std::min(c * part_size, size);
+        const size_t end = std::min(begin + part_size, size);
+        field_vector_dot<FieldT>::compute(partial[c], a, bs, begin, end);
+    }
+
+    out = partial[0];
+    for (size_t c = 1; c < num_parts; ++c)
+    {
+        for (size_t j = 0; j < bs.size(); ++j)
+        {
+            out[j] = out[j] + partial[c][j];
+        }
+    }
+}
+
+template<typename FieldT>
+FieldT vector_inner_product(const std::vector<FieldT> &a, const std::vector<FieldT> &b)
+{
+    ASSERT(a.size() == b.size());
+
+    std::vector<FieldT> result;
+    field_vector_inner_products(result, a.data(), std::vector<const FieldT*>(1, b.data()), a.size());
+    return result[0];
+}
+
+template<typename FieldT>
+void vector_inner_products(std::vector<FieldT> &out, const std::vector<FieldT> &a, const std::vector<std::vector<FieldT> > &bs)
+{
+    std::vector<const FieldT*> b_data;
+    b_data.reserve(bs.size());
+    for (const std::vector<FieldT> &b : bs)
+    {
+        ASSERT(b.size() == a.size());
+        b_data.emplace_back(b.data());
+    }
+
+    field_vector_inner_products(out, a.data(), b_data, a.size());
+}
+
+template<typename FieldT>
+void geometric_sequence(std::vector<FieldT> &out, const FieldT &start, const FieldT &ratio, const size_t size)
+{
+    const FieldT start_copy = start, ratio_copy = ratio; // either may live in out
+    out.resize(size);
+
+    for_each_field_vector_block(size, [&](const size_t begin, const size_t end) {
+        FieldT acc = start_copy * power<FieldT>(ratio_copy, static_cast<unsigned long>(begin));
+        for (size_t i = begin; i < end; ++i)
+        {
+            out[i] = acc;
+            acc *= ratio_copy;
+        }
+    });
+}
+
+template<typename FieldT>
+std::vector<FieldT> geometric_sequence(const FieldT &start, const FieldT &ratio, const size_t size)
+{
+    std::vector<FieldT> result;
+    geometric_sequence(result, start, ratio, size);
+    return result;
+}
+
+template<typename FieldT>
+struct field_vector_conversion {
+    static void as_bigints(std::vector<bigint<FieldT::num_limbs> > &out,
+                           typename std::vector<FieldT>::const_iterator a,
+                           typename std::vector<FieldT>::const_iterator a_end)
+    {
+        out.resize(a_end - a);
+
+        for_each_field_vector_block(out.size(), [&](const size_t begin, const size_t end) {
+            for (size_t i = begin; i < end; ++i)
+            {
+                out[i] = a[i].as_bigint();
+            }
+        });
+    }
+};
+
+template<mp_size_t n, const bigint<n>& modulus>
+struct field_vector_conversion<Fp_model<n, modulus> > {
+    typedef Fp_model<n, modulus> FieldT;
+
+    static void as_bigints(std::vector<bigint<n> > &out,
+                           typename std::vector<FieldT>::const_iterator a,
+                           typename std::vector<FieldT>::const_iterator a_end)
+    {
+        /* only IFMA packs, multiplies and unpacks faster than Fp_model::as_bigint */
+        if (fp_batch_default_backend() == fp_batch_backend_avx512ifma)
+        {
+            Fp_batch<n, modulus>::as_bigints(a, a_end, out);
+            return;
+        }
+
+        out.resize(a_end - a);
+
+        for_each_field_vector_block(out.size(), [&](const size_t begin, const size_t end) {
+            for (size_t i = begin; i < end; ++i)
+            {
+                out[i] = a[i].as_bigint();
+            }
+        });
+    }
+};
+
+template<typename FieldT>
+void vector_as_bigints(std::vector<bigint<FieldT::num_limbs> > &out, const std::vector<FieldT> &a)
+{
+    field_vector_conversion<FieldT>::as_bigints(out, a.begin(), a.end());
+}
+
+template<typename FieldT>
+void vector_as_bigints(std::vector<bigint<FieldT::num_limbs> > &out,
+                       typename std::vector<FieldT>::const_iterator begin,
+                       typename std::vector<FieldT>::const_iterator end)
+{
+    field_vector_conversion<FieldT>::as_bigints(out, begin, end);
+}
+
+template<typename FieldT>
+void vector_from_bigints(std::vector<FieldT> &out, const std::vector<bigint<FieldT::num_limbs> > &a)
+{
+    out.resize(a.size());
+
+    for_each_field_vector_block(a.size(), [&](const size_t begin, const size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            out[i] = FieldT(a[i]);
+        }
+    });
+}
+
+} // libff
+
+#endif // FIELD_VECTOR_OPS_TCC_
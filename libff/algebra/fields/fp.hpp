@@ -106,6 +106,8 @@ public:
     Fp_model& invert();
     Fp_model inverse() const;
     Fp_model sqrt() const; // HAS TO BE A SQUARE (else does not terminate)
+    bool is_square() const;
+    bool try_sqrt(Fp_model &root) const; // returns false, leaving root unchanged, if not a square
 
     Fp_model operator^(const unsigned long pow) const;
     template<mp_size_t m>
@@ -723,56 +723,26 @@ Fp_model<n, modulus> Fp_model<n,modulus>::random_element() /// returns random el
 template<mp_size_t n, const bigint<n>& modulus>
 Fp_model<n,modulus> Fp_model<n,modulus>::sqrt() const
 {
-    Fp_model<n,modulus> one = Fp_model<n,modulus>::one();
-
-    size_t v = Fp_model<n,modulus>::s;
-    Fp_model<n,modulus> z = Fp_model<n,modulus>::nqr_to_t;
-    Fp_model<n,modulus> w = (*this)^Fp_model<n,modulus>::t_minus_1_over_2;
-    Fp_model<n,modulus> x = (*this) * w;
-    Fp_model<n,modulus> b = x * w; // b = (*this)^t
-
-#if DEBUG
-    // check if square with euler's criterion
-    Fp_model<n,modulus> check = b;
-    for (size_t i = 0; i < v-1; ++i)
-    {
-        check = check.squared();
-    }
-    if (check != one)
-    {
-        ASSERT(0);
-    }
-#endif
+    return tonelli_shanks_sqrt<Fp_model<n,modulus> >(*this);
+}
 
-    // compute square root with Tonelli--Shanks
-    // (does not terminate if not a square!)
+template<mp_size_t n, const bigint<n>& modulus>
+bool Fp_model<n,modulus>::is_square() const
+{
+    /* R is an even power of two, so x*R and x have the same Legendre symbol */
+    return (jacobi_symbol(this->mont_repr, modulus) != -1);
+}
 
-    while (b != one)
+template<mp_size_t n, const bigint<n>& modulus>
+bool Fp_model<n,modulus>::try_sqrt(Fp_model &root) const
+{
+    if (!this->is_square())
     {
-        size_t m = 0;
-        Fp_model<n,modulus> b2m = b;
-        while (b2m != one)
-        {
-            /* invariant: b2m = b^(2^m) after entering this loop */
-            b2m = b2m.squared();
-            m += 1;
-        }
-
-        int j = v-m-1;
-        w = z;
-        while (j > 0)
-        {
-            w = w.squared();
-            --j;
-        } // w = z^2^(v-m-1)
-
-        z = w.squared();
-        b = b * z;
-        x = x * w;
-        v = m;
+        return false;
     }
 
-    return x;
+    root = this->sqrt();
+    return true;
 }
 
 template<mp_size_t n, const bigint<n>& modulus>
@@ -69,6 +69,8 @@ public:
     Fp2_model inverse() const;
     Fp2_model Frobenius_map(unsigned long power) const;
     Fp2_model sqrt() const; // HAS TO BE A SQUARE (else does not terminate)
+    bool is_square() const;
+    bool try_sqrt(Fp2_model &root) const; // returns false, leaving root unchanged, if not a square
     Fp2_model squared_karatsuba() const;
     Fp2_model squared_complex() const;
 
@@ -145,56 +145,56 @@ Fp2_model<n,modulus> Fp2_model<n,modulus>::Frobenius_map(unsigned long power) co
 template<mp_size_t n, const bigint<n>& modulus>
 Fp2_model<n,modulus> Fp2_model<n,modulus>::sqrt() const
 {
-    Fp2_model<n,modulus> one = Fp2_model<n,modulus>::one();
+    /* the strategy only depends on the field, so it is chosen once */
+    static const bool use_complex_method = (my_Fp::s == 1 && non_residue == -my_Fp::one());
+    if (!use_complex_method)
+    {
+        return tonelli_shanks_sqrt<Fp2_model<n,modulus> >(*this);
+    }
+
+    /*
+      "Square root computation over even extension fields", Adj and Rodriguez-Henriquez; Algorithm 9,
+      for p = 3 (mod 4) and U^2 = -1.
+      Since p = 2*t + 1 here, (p-3)/4 = (t-1)/2 and (p-1)/2 = euler.
+    */
+    static const sliding_window_exponent p_minus_3_over_4(my_Fp::t_minus_1_over_2);
+    static const sliding_window_exponent p_minus_1_over_2(my_Fp::euler);
+
+    const Fp2_model<n,modulus> one = Fp2_model<n,modulus>::one();
+    const Fp2_model<n,modulus> a1 = power<Fp2_model<n,modulus> >(*this, p_minus_3_over_4);
+    const Fp2_model<n,modulus> x0 = a1 * (*this);
+    const Fp2_model<n,modulus> alpha = a1 * x0; // alpha = (*this)^((p-1)/2)
 
-    size_t v = Fp2_model<n,modulus>::s;
-    Fp2_model<n,modulus> z = Fp2_model<n,modulus>::nqr_to_t;
-    Fp2_model<n,modulus> w = (*this)^Fp2_model<n,modulus>::t_minus_1_over_2;
-    Fp2_model<n,modulus> x = (*this) * w;
-    Fp2_model<n,modulus> b = x * w; // b = (*this)^t
+    const Fp2_model<n,modulus> root = (alpha == -one ?
+                                       Fp2_model<n,modulus>(-x0.c1, x0.c0) : // x0 * U
+                                       power<Fp2_model<n,modulus> >(one + alpha, p_minus_1_over_2) * x0);
 
 #if DEBUG
-    // check if square with euler's criterion
-    Fp2_model<n,modulus> check = b;
-    for (size_t i = 0; i < v-1; ++i)
-    {
-        check = check.squared();
-    }
-    if (check != one)
-    {
-        ASSERT(0);
-    }
+    // the method returns a wrong value, not a failure, on non-squares
+    ASSERT(root.squared() == *this);
 #endif
 
-    // compute square root with Tonelli--Shanks
-    // (does not terminate if not a square!)
+    return root;
+}
 
-    while (b != one)
+template<mp_size_t n, const bigint<n>& modulus>
+bool Fp2_model<n,modulus>::is_square() const
+{
+    /* x^((p^2-1)/2) = N(x)^((p-1)/2), so x is a square iff its norm is */
+    const my_Fp norm = c0.squared() - non_residue * c1.squared();
+    return norm.is_square();
+}
+
+template<mp_size_t n, const bigint<n>& modulus>
+bool Fp2_model<n,modulus>::try_sqrt(Fp2_model &root) const
+{
+    if (!this->is_square())
     {
-        size_t m = 0;
-        Fp2_model<n,modulus> b2m = b;
-        while (b2m != one)
-        {
-            /* invariant: b2m = b^(2^m) after entering this loop */
-            b2m = b2m.squared();
-            m += 1;
-        }
-
-        int j = v-m-1;
-        w = z;
-        while (j > 0)
-        {
-            w = w.squared();
-            --j;
-        } // w = z^2^(v-m-1)
-
-        z = w.squared();
-        b = b * z;
-        x = x * w;
-        v = m;
+        return false;
     }
 
-    return x;
+    root = this->sqrt();
+    return true;
 }
 
 template<mp_size_t n, const bigint<n>& modulus>
@@ -70,6 +70,8 @@ public:
     Fp3_model inverse() const;
     Fp3_model Frobenius_map(unsigned long power) const;
     Fp3_model sqrt() const; // HAS TO BE A SQUARE (else does not terminate)
+    bool is_square() const;
+    bool try_sqrt(Fp3_model &root) const; // returns false, leaving root unchanged, if not a square
 
     template<mp_size_t m>
     Fp3_model operator^(const bigint<m> &other) const;
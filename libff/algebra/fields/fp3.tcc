@@ -147,56 +147,33 @@ Fp3_model<n,modulus> Fp3_model<n,modulus>::Frobenius_map(unsigned long power) co
 template<mp_size_t n, const bigint<n>& modulus>
 Fp3_model<n,modulus> Fp3_model<n,modulus>::sqrt() const
 {
-    Fp3_model<n,modulus> one = Fp3_model<n,modulus>::one();
-
-    size_t v = Fp3_model<n,modulus>::s;
-    Fp3_model<n,modulus> z = Fp3_model<n,modulus>::nqr_to_t;
-    Fp3_model<n,modulus> w = (*this)^Fp3_model<n,modulus>::t_minus_1_over_2;
-    Fp3_model<n,modulus> x = (*this) * w;
-    Fp3_model<n,modulus> b = x * w; // b = (*this)^t
-
-#if DEBUG
-    // check if square with euler's criterion
-    Fp3_model<n,modulus> check = b;
-    for (size_t i = 0; i < v-1; ++i)
-    {
-        check = check.squared();
-    }
-    if (check != one)
-    {
-        ASSERT(0);
-    }
-#endif
+    return tonelli_shanks_sqrt<Fp3_model<n,modulus> >(*this);
+}
 
-    // compute square root with Tonelli--Shanks
-    // (does not terminate if not a square!)
+template<mp_size_t n, const bigint<n>& modulus>
+bool Fp3_model<n,modulus>::is_square() const
+{
+    /*
+      x^((p^3-1)/2) = N(x)^((p-1)/2), so x is a square iff its norm
+      N(x) = c0^3 + non_residue * c1^3 + non_residue^2 * c2^3 - 3 * non_residue * c0 * c1 * c2
+      is a square
+    */
+    const my_Fp nr_c1_c2 = non_residue * c1 * c2;
+    const my_Fp norm = c0.squared() * c0 + non_residue * (c1.squared() * c1 + non_residue * c2.squared() * c2)
+        - (nr_c1_c2 + nr_c1_c2 + nr_c1_c2) * c0;
+    return norm.is_square();
+}
 
-    while (b != one)
+template<mp_size_t n, const bigint<n>& modulus>
+bool Fp3_model<n,modulus>::try_sqrt(Fp3_model &root) const
+{
+    if (!this->is_square())
     {
-        size_t m = 0;
-        Fp3_model<n,modulus> b2m = b;
-        while (b2m != one)
-        {
-            /* invariant: b2m = b^(2^m) after entering this loop */
-            b2m = b2m.squared();
-            m += 1;
-        }
-
-        int j = v-m-1;
-        w = z;
-        while (j > 0)
-        {
-            w = w.squared();
-            --j;
-        } // w = z^2^(v-m-1)
-
-        z = w.squared();
-        b = b * z;
-        x = x * w;
-        v = m;
+        return false;
     }
 
-    return x;
+    root = this->sqrt();
+    return true;
 }
 
 template<mp_size_t n, const bigint<n>& modulus>
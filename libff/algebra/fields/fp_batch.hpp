@@ -0,0 +1,154 @@
+/** @file
+ *****************************************************************************
+
+ Declaration of a struct-of-arrays batch of elements of F[p], for arithmetic
+ on many independent elements at once with SIMD instructions.
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef FP_BATCH_HPP_
+#define FP_BATCH_HPP_
+
+#include <cstdint>
+#include <vector>
+
+#include <libff/algebra/fields/bigint.hpp>
+#include <libff/algebra/fields/fp.hpp>
+
+namespace libff {
+
+enum fp_batch_backend {
+    /* portable code, radix 2^26 */
+    fp_batch_backend_scalar,
+    /* AVX2, 4 elements per instruction, radix 2^26 */
+    fp_batch_backend_avx2,
+    /* AVX-512 IFMA, 8 elements per instruction, radix 2^52 */
+    fp_batch_backend_avx512ifma
+};
+
+/* Whether this build, and the CPU it runs on, support backend. */
+inline bool fp_batch_backend_supported(const fp_batch_backend backend);
+
+/* The fastest supported backend, detected with CPUID on first use. */
+inline fp_batch_backend fp_batch_default_backend();
+
+/**
+ * A vector of elements of F[p] stored as struct-of-arrays: blocks of 8
+ * elements, each block holding limb 0 of all 8 elements, then limb 1, and so
+ * on, in radix 2^26 or 2^52 depending on the backend. Within a batch,
+ * elements are kept in a Montgomery form of their own, x * 2^(radix * limbs)
+ * mod p, and all arithmetic is element-wise.
+ *
+ * Converting from and to std::vector<Fp_model> costs one batch multiplication
+ * each way, so batches pay off when several operations are chained on them.
+ * Under MULTICORE, operations on large batches are split across threads.
+ */
+template<mp_size_t n, const bigint<n>& modulus>
+class Fp_batch {
+public:
+    typedef Fp_model<n, modulus> field_type;
+    static const size_t block_size = 8;
+
+    /* size zeros */
+    explicit Fp_batch(const size_t size, const fp_batch_backend backend = fp_batch_default_backend());
+    explicit Fp_batch(const std::vector<field_type> &v, const fp_batch_backend backend = fp_batch_default_backend());
+
+    size_t size() const { return this->num_elements; }
+    fp_batch_backend backend() const { return this->batch_backend; }
+
+    field_type get(const size_t i) const;
+    void set(const size_t i, const field_type &el);
+
+    std::vector<field_type> to_vector() const;
+    void to_vector(std::vector<field_type> &out) const;
+    /* the standard (not Montgomery) representations, as Fp_model::as_bigint */
+    std::vector<bigint<n> > as_bigints() const;
+    void as_bigints(std::vector<bigint<n> > &out) const;
+    /**
+     * out[i] = begin[i].as_bigint(), without building a batch: each chunk of
+     * the input is packed, multiplied once, and unpacked while it is still in
+     * cache.
+     */
+    static void as_bigints(typename std::vector<field_type>::const_iterator begin,
+                           typename std::vector<field_type>::const_iterator end,
+                           std::vector<bigint<n> > &out,
+                           const fp_batch_backend backend = fp_batch_default_backend());
+
+    Fp_batch operator+(const Fp_batch &other) const;
+    Fp_batch operator-(const Fp_batch &other) const;
+    Fp_batch operator*(const Fp_batch &other) const;
+    Fp_batch operator*(const field_type &c) const;
+    Fp_batch& operator*=(const Fp_batch &other);
+    Fp_batch& operator*=(const field_type &c);
+    Fp_batch squared() const;
+
+private:
+    struct radix_params {
+        size_t radix_bits;
+        size_t num_limbs;
+        uint64_t mask;
+        uint64_t inv; // -p^(-1) mod 2^radix_bits
+        std::vector<uint64_t> p;
+        std::vector<uint64_t> from_montgomery; // R_batch^2 / R mod p, where R = 2^(64*n)
+        std::vector<uint64_t> to_montgomery;   // R mod p
+        std::vector<uint64_t> to_canonical;    // 1
+        std::vector<uint64_t> montgomery_to_canonical; // R_batch / R mod p
+        field_type to_batch_factor;            // an element with value R_batch
+        field_type from_batch_factor;          // an element with value R / R_batch
+    };
+
+    static const radix_params& params_for(const fp_batch_backend backend);
+
+    static const size_t max_limbs_26 = (64 * n + 2 + 25) / 26;
+    static const size_t max_limbs_52 = (64 * n + 2 + 51) / 52;
+
+    static void mul_blocks(const fp_batch_backend backend, const radix_params &params,
+                           const uint64_t *a, const uint64_t *b, const size_t b_stride,
+                           uint64_t *out, const size_t num_blocks);
+    static void mul_blocks_serial(const fp_batch_backend backend, const radix_params &params,
+                                  const uint64_t *a, const uint64_t *b, const size_t b_stride,
+                                  uint64_t *out, const size_t num_blocks);
+    static void mul_blocks_scalar(const radix_params &params,
+                                  const uint64_t *a, const uint64_t *b, const size_t b_stride,
+                                  uint64_t *out, const size_t num_blocks);
+#if defined(__x86_64__) && defined(USE_ASM)
+    static void mul_blocks_avx2(const radix_params &params,
+                                const uint64_t *a, const uint64_t *b, const size_t b_stride,
+                                uint64_t *out, const size_t num_blocks);
+    static void mul_blocks_avx512ifma(const radix_params &params,
+                                      const uint64_t *a, const uint64_t *b, const size_t b_stride,
+                                      uint64_t *out, const size_t num_blocks);
+#endif
+
+    void pack(const size_t i, const bigint<n> &x);
+    bigint<n> unpack(const size_t i) const;
+    static void pack_lane(const radix_params &params, uint64_t *block, const size_t lane, const bigint<n> &x);
+    static bigint<n> unpack_lane(const radix_params &params, const uint64_t *block, const size_t lane);
+    /* this * (constant with radix limbs c), element-wise */
+    Fp_batch mul_by_constant(const std::vector<uint64_t> &c) const;
+
+    size_t num_elements;
+    size_t num_blocks;
+    fp_batch_backend batch_backend;
+    const radix_params *params;
+    std::vector<uint64_t> limbs;
+};
+
+/* fp_batch_type<FieldT>::type is the Fp_batch of the prime field FieldT. */
+template<typename FieldT>
+struct fp_batch_type;
+
+template<mp_size_t n, const bigint<n>& modulus>
+struct fp_batch_type<Fp_model<n, modulus> > {
+    typedef Fp_batch<n, modulus> type;
+};
+
+} // libff
+
+#include <libff/algebra/fields/fp_batch.tcc>
+
+#endif // FP_BATCH_HPP_
@@ -0,0 +1,719 @@
+/** @file
+ *****************************************************************************
+
+ Implementation of struct-of-arrays batches of elements of F[p].
+
+ See fp_batch.hpp .
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef FP_BATCH_TCC_
+#define FP_BATCH_TCC_
+
+#include <algorithm>
+
+#if defined(__x86_64__) && defined(USE_ASM)
+#include <immintrin.h>
+#endif
+
+#include <libff/common/assert.hpp>
+
+namespace libff {
+
+bool fp_batch_backend_supported(const fp_batch_backend backend)
+{
+    switch (backend)
+    {
+    case fp_batch_backend_scalar:
+        return true;
+#if defined(__x86_64__) && defined(USE_ASM)
+    case fp_batch_backend_avx2:
+        return __builtin_cpu_supports("avx2");
+    case fp_batch_backend_avx512ifma:
+        return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512ifma");
+#endif
+    default:
+        return false;
+    }
+}
+
+fp_batch_backend fp_batch_default_backend()
+{
+    static const fp_batch_backend backend =
+        fp_batch_backend_supported(fp_batch_backend_avx512ifma) ? fp_batch_backend_avx512ifma :
+        fp_batch_backend_supported(fp_batch_backend_avx2) ? fp_batch_backend_avx2 :
+        fp_batch_backend_scalar;
+    return backend;
+}
+
+/* radix_bits bits of x starting at bit offset */
+template<mp_size_t n>
+uint64_t fp_batch_extract_bits(const bigint<n> &x, const size_t offset, const size_t radix_bits)
+{
+    const size_t word = offset / GMP_NUMB_BITS;
+    const size_t shift = offset % GMP_NUMB_BITS;
+    if (word >= n)
+    {
+        return 0;
+    }
+
+    uint64_t result = x.data[word] >> shift;
+    if (shift + radix_bits > GMP_NUMB_BITS && word + 1 < n)
+    {
+        result |= x.data[word + 1] << (GMP_NUMB_BITS - shift);
+    }
+    return result & ((1ull << radix_bits) - 1);
+}
+
+template<mp_size_t n>
+std::vector<uint64_t> fp_batch_split(const bigint<n> &x, const size_t radix_bits, const size_t num_limbs)
+{
+    std::vector<uint64_t> result(num_limbs);
+    for (size_t k = 0; k < num_limbs; ++k)
+    {
+        result[k] = fp_batch_extract_bits(x, k * radix_bits, radix_bits);
+    }
+    return result;
+}
+
+template<mp_size_t n, const bigint<n>& modulus>
+const typename Fp_batch<n, modulus>::radix_params& Fp_batch<n, modulus>::params_for(const fp_batch_backend backend)
+{
+    /* R_batch = 2^(radix_bits * num_limbs) > 4p, so Montgomery products of reduced inputs are below 2p */
+    auto make_params = [](const size_t radix_bits) {
+        radix_params params;
+        params.radix_bits = radix_bits;
+        params.num_limbs = (modulus.num_bits() + 2 + radix_bits - 1) / radix_bits;
+        params.mask = (1ull << radix_bits) - 1;
+
+        /* Newton iteration for p^(-1) mod 2^64 */
+        uint64_t p_inv = 1;
+        for (size_t i = 0; i < 6; ++i)
+        {
+            p_inv *= 2 - modulus.data[0] * p_inv;
+        }
+        params.inv = (0 - p_inv) & params.mask;
+
+        params.p = fp_batch_split(modulus, radix_bits, params.num_limbs);
+
+        const field_type two(2);
+        const field_type R_batch = two ^ (radix_bits * params.num_limbs);
+        const field_type R = two ^ static_cast<unsigned long>(n * GMP_NUMB_BITS);
+        params.from_montgomery = fp_batch_split((R_batch.squared() * R.inverse()).as_bigint(), radix_bits, params.num_limbs);
+        params.to_montgomery = fp_batch_split(R.as_bigint(), radix_bits, params.num_limbs);
+        params.to_canonical = fp_batch_split(bigint<n>(1ul), radix_bits, params.num_limbs);
+        params.montgomery_to_canonical = fp_batch_split((R_batch * R.inverse()).as_bigint(), radix_bits, params.num_limbs);
+        params.to_batch_factor = R_batch;
+        params.from_batch_factor = R * R_batch.inverse();
+
+        return params;
+    };
+
+    static const radix_params params_26 = make_params(26);
+    if (backend == fp_batch_backend_avx512ifma)
+    {
+        static const radix_params params_52 = make_params(52);
+        return params_52;
+    }
+    return params_26;
+}
+
+template<mp_size_t n, const bigint<n>& modulus>
+Fp_batch<n, modulus>::Fp_batch(const size_t size, const fp_batch_backend backend) :
+    num_elements(size),
+    num_blocks((size + block_size - 1) / block_size),
+    batch_backend(backend),
+    params(&params_for(backend))
+{
+    ASSERT(fp_batch_backend_supported(backend));
+    this->limbs.resize(this->num_blocks * this->params->num_limbs * block_size, 0);
+}
+
+template<mp_size_t n, const bigint<n>& modulus>
+Fp_batch<n, modulus>::Fp_batch(const std::vector<field_type> &v, const fp_batch_backend backend) :
+    Fp_batch(v.size(), backend)
+{
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+    for (size_t i = 0; i < v.size(); ++i)
+    {
+        this->pack(i, v[i].mont_repr);
+    }
+
+    std::vector<uint64_t> c(this->params->num_limbs * block_size);
+    for (size_t k = 0; k < this->params->num_limbs; ++k)
+    {
+        std::fill(c.begin() + k * block_size, c.begin() + (k + 1) * block_size, this->params->from_montgomery[k]);
+    }
+    mul_blocks(this->batch_backend, *this->params, this->limbs.data(), c.data(), 0, this->limbs.data(), this->num_blocks);
+}
+
+template<mp_size_t n, const bigint<n>& modulus>
+void Fp_batch<n, modulus>::pack(const size_t i, const bigint<n> &x)
+{
+    pack_lane(*this->params, &this->limbs[(i / block_size) * this->params->num_limbs * block_size], i % block_size, x);
+}
+
+template<mp_size_t n, const bigint<n>& modulus>
+bigint<n> Fp_batch<n, modulus>::unpack(const size_t i) const
+{
+    return unpack_lane(*this->params, &this->limbs[(i / block_size) * this->params->num_limbs * block_size], i % block_size);
+}
+
+template<mp_size_t n, const bigint<n>& modulus>
+void Fp_batch<n, modulus>::pack_lane(const radix_params &params, uint64_t *block, const size_t lane, const bigint<n> &x)
+{
+    for (size_t k = 0; k < params.num_limbs; ++k)
+    {
+        block[k * block_size + lane] = fp_batch_extract_bits(x, k * params.radix_bits, params.radix_bits);
+    }
+}
+
+template<mp_size_t n, const bigint<n>& modulus>
+bigint<n> Fp_batch<n, modulus>::unpack_lane(const radix_params &params, const uint64_t *block, const size_t lane)
+{
+    const size_t m = params.num_limbs;
+    const size_t radix_bits = params.radix_bits;
+
+    bigint<n> result;
+    for (size_t k = 0; k < m; ++k)
+    {
+        const uint64_t limb = block[k * block_size + lane];
+        const size_t word = (k * radix_bits) / GMP_NUMB_BITS;
+        const size_t shift = (k * radix_bits) % GMP_NUMB_BITS;
+        if (word < n)
+        {
+            result.data[word] |= limb << shift;
+        }
+        if (shift + radix_bits > GMP_NUMB_BITS && word + 1 < n)
+        {
+            result.data[word + 1] |= limb >> (GMP_NUMB_BITS - shift);
+        }
+    }
+    return result;
+}
+
+template<mp_size_t n, const bigint<n>& modulus>
+typename Fp_batch<n, modulus>::field_type Fp_batch<n, modulus>::get(const size_t i) const
+{
+    field_type el;
+    el.mont_repr = this->unpack(i);
+    return el * this->params->from_batch_factor;
+}
+
+template<mp_size_t n, const bigint<n>& modulus>
+void Fp_batch<n, modulus>::set(const size_t i, const field_type &el)
+{
+    this->pack(i, (el * this->params->to_batch_factor).as_bigint());
+}
+
+template<mp_size_t n, const bigint<n>& modulus>
+std::vector<typename Fp_batch<n, modulus>::field_type> Fp_batch<n, modulus>::to_vector() const
+{
+    std::vector<field_type> result;
+    this->to_vector(result);
+    return result;
+}
+
+template<mp_size_t n, const bigint<n>& modulus>
+void Fp_batch<n, modulus>::to_vector(std::vector<field_type> &out) const
+{
+    const Fp_batch tmp = this->mul_by_constant(this->params->to_montgomery);
+    out.resize(this->num_elements);
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+    for (size_t i = 0; i < this->num_elements; ++i)
+    {
+        out[i].mont_repr = tmp.unpack(i);
+    }
+}
+
+template<mp_size_t n, const bigint<n>& modulus>
+std::vector<bigint<n> > Fp_batch<n, modulus>::as_bigints() const
+{
+    std::vector<bigint<n> > result;
+    this->as_bigints(result);
+    return result;
+}
+
+template<mp_size_t n, const bigint<n>& modulus>
+void Fp_batch<n, modulus>::as_bigints(std::vector<bigint<n> > &out) const
+{
+    const Fp_batch tmp = this->mul_by_constant(this->params->to_canonical);
+    out.resize(this->num_elements);
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+    for (size_t i = 0; i < this->num_elements; ++i)
+    {
+        out[i] = tmp.unpack(i);
+    }
+}
+
+template<mp_size_t n, const bigint<n>& modulus>
+void Fp_batch<n, modulus>::as_bigints(typename std::vector<field_type>::const_iterator begin,
+                                      typename std::vector<field_type>::const_iterator end,
+                                      std::vector<bigint<n> > &out,
+                                      const fp_batch_backend backend)
+{
+    ASSERT(fp_batch_backend_supported(backend));
+    const radix_params &params = params_for(backend);
+    const size_t m = params.num_limbs;
+    const size_t size = end - begin;
+    const size_t chunk_blocks = 64;
+    const size_t chunk_size = chunk_blocks * block_size;
+    const size_t num_chunks = (size + chunk_size - 1) / chunk_size;
+
+    /* (x * R) * (R_batch / R) / R_batch = x */
+    std::vector<uint64_t> c(m * block_size);
+    for (size_t k = 0; k < m; ++k)
+    {
+        std::fill(c.begin() + k * block_size, c.begin() + (k + 1) * block_size, params.montgomery_to_canonical[k]);
+    }
+
+    out.resize(size);
+
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+    for (size_t chunk = 0; chunk < num_chunks; ++chunk)
+    {
+        const size_t chunk_begin = chunk * chunk_size;
+        const size_t chunk_end = std::min(chunk_begin + chunk_size, size);
+        const size_t count = (chunk_end - chunk_begin + block_size - 1) / block_size;
+
+        uint64_t buf[chunk_blocks * max_limbs_26 * block_size];
+        std::fill(buf, buf + count * m * block_size, 0);
+        for (size_t i = chunk_begin; i < chunk_end; ++i)
+        {
+            const size_t j = i - chunk_begin;
+            pack_lane(params, buf + (j / block_size) * m * block_size, j % block_size, begin[i].mont_repr);
+        }
+
+        mul_blocks_serial(backend, params, buf, c.data(), 0, buf, count);
+
+        for (size_t i = chunk_begin; i < chunk_end; ++i)
+        {
+            const size_t j = i - chunk_begin;
+            out[i] = unpack_lane(params, buf + (j / block_size) * m * block_size, j % block_size);
+        }
+    }
+}
+
+template<mp_size_t n, const bigint<n>& modulus>
+Fp_batch<n, modulus> Fp_batch<n, modulus>::operator+(const Fp_batch &other) const
+{
+    ASSERT(this->num_elements == other.num_elements && this->batch_backend == other.batch_backend);
+    Fp_batch result(this->num_elements, this->batch_backend);
+
+    const size_t m = this->params->num_limbs;
+    const size_t radix_bits = this->params->radix_bits;
+    const uint64_t mask = this->params->mask;
+    const std::vector<uint64_t> &p = this->params->p;
+
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+    for (size_t blk = 0; blk < this->num_blocks; ++blk)
+    {
+        const uint64_t *a = &this->limbs[blk * m * block_size];
+        const uint64_t *b = &other.limbs[blk * m * block_size];
+        uint64_t *out = &result.limbs[blk * m * block_size];
+
+        for (size_t l = 0; l < block_size; ++l)
+        {
+            /* s = a + b < 2p, then d = s - p, kept if it does not borrow */
+            uint64_t s[max_limbs_26], d[max_limbs_26];
+            uint64_t carry = 0, borrow = 0;
+            for (size_t k = 0; k < m; ++k)
+            {
+                s[k] = a[k * block_size + l] + b[k * block_size + l] + carry;
+                carry = s[k] >> radix_bits;
+                s[k] &= mask;
+                d[k] = s[k] + (1ull << radix_bits) - p[k] - borrow;
+                borrow = 1 - (d[k] >> radix_bits);
+                d[k] &= mask;
+            }
+            for (size_t k = 0; k < m; ++k)
+            {
+                out[k * block_size + l] = borrow ? s[k] : d[k];
+            }
+        }
+    }
+
+    return result;
+}
+
+template<mp_size_t n, const bigint<n>& modulus>
+Fp_batch<n, modulus> Fp_batch<n, modulus>::operator-(const Fp_batch &other) const
+{
+    ASSERT(this->num_elements == other.num_elements && this->batch_backend == other.batch_backend);
+    Fp_batch result(this->num_elements, this->batch_backend);
+
+    const size_t m = this->params->num_limbs;
+    const size_t radix_bits = this->params->radix_bits;
+    const uint64_t mask = this->params->mask;
+    const std::vector<uint64_t> &p = this->params->p;
+
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+    for (size_t blk = 0; blk < this->num_blocks; ++blk)
+    {
+        const uint64_t *a = &this->limbs[blk * m * block_size];
+        const uint64_t *b = &other.limbs[blk * m * block_size];
+        uint64_t *out = &result.limbs[blk * m * block_size];
+
+        for (size_t l = 0; l < block_size; ++l)
+        {
+            /* d = a - b, then s = d + p, kept if the subtraction borrowed */
+            uint64_t d[max_limbs_26], s[max_limbs_26];
+            uint64_t borrow = 0, carry = 0;
+            for (size_t k = 0; k < m; ++k)
+            {
+                d[k] = a[k * block_size + l] + (1ull << radix_bits) - b[k * block_size + l] - borrow;
+                borrow = 1 - (d[k] >> radix_bits);
+                d[k] &= mask;
+                s[k] = d[k] + p[k] + carry;
+                carry = s[k] >> radix_bits;
+                s[k] &= mask;
+            }
+            for (size_t k = 0; k < m; ++k)
+            {
+                out[k * block_size + l] = borrow ? s[k] : d[k];
+            }
+        }
+    }
+
+    return result;
+}
+
+template<mp_size_t n, const bigint<n>& modulus>
+Fp_batch<n, modulus> Fp_batch<n, modulus>::operator*(const Fp_batch &other) const
+{
+    Fp_batch result(*this);
+    result *= other;
+    return result;
+}
+
+template<mp_size_t n, const bigint<n>& modulus>
+Fp_batch<n, modulus> Fp_batch<n, modulus>::operator*(const field_type &c) const
+{
+    return this->mul_by_constant(fp_batch_split((c * this->params->to_batch_factor).as_bigint(),
+                                                this->params->radix_bits, this->params->num_limbs));
+}
+
+template<mp_size_t n, const bigint<n>& modulus>
+Fp_batch<n, modulus>& Fp_batch<n, modulus>::operator*=(const Fp_batch &other)
+{
+    ASSERT(this->num_elements == other.num_elements && this->batch_backend == other.batch_backend);
+    mul_blocks(this->batch_backend, *this->params, this->limbs.data(), other.limbs.data(),
+               this->params->num_limbs * block_size, this->limbs.data(), this->num_blocks);
+    return *this;
+}
+
+template<mp_size_t n, const bigint<n>& modulus>
+Fp_batch<n, modulus>& Fp_batch<n, modulus>::operator*=(const field_type &c)
+{
+    *this = (*this) * c;
+    return *this;
+}
+
+template<mp_size_t n, const bigint<n>& modulus>
+Fp_batch<n, modulus> Fp_batch<n, modulus>::squared() const
+{
+    return (*this) * (*this);
+}
+
+template<mp_size_t n, const bigint<n>& modulus>
+Fp_batch<n, modulus> Fp_batch<n, modulus>::mul_by_constant(const std::vector<uint64_t> &c) const
+{
+    std::vector<uint64_t> c_block(this->params->num_limbs * block_size);
+    for (size_t k = 0; k < this->params->num_limbs; ++k)
+    {
+        std::fill(c_block.begin() + k * block_size, c_block.begin() + (k + 1) * block_size, c[k]);
+    }
+
+    Fp_batch result(this->num_elements, this->batch_backend);
+    mul_blocks(this->batch_backend, *this->params, this->limbs.data(), c_block.data(), 0,
+               result.limbs.data(), this->num_blocks);
+    return result;
+}
+
+template<mp_size_t n, const bigint<n>& modulus>
+void Fp_batch<n, modulus>::mul_blocks(const fp_batch_backend backend, const radix_params &params,
+                                      const uint64_t *a, const uint64_t *b, const size_t b_stride,
+                                      uint64_t *out, const size_t num_blocks)
+{
+    const size_t block_limbs = params.num_limbs * block_size;
+    const size_t chunk_blocks = 64;
+    const size_t num_chunks = (num_blocks + chunk_blocks - 1) / chunk_blocks;
+
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+    for (size_t chunk = 0; chunk < num_chunks; ++chunk)
+    {
+        const size_t begin = chunk * chunk_blocks;
+        const size_t count = std::min(chunk_blocks, num_blocks - begin);
+        const uint64_t *a_chunk = a + begin * block_limbs;
+        const uint64_t *b_chunk = b + begin * b_stride;
+        uint64_t *out_chunk = out + begin * block_limbs;
+
+        mul_blocks_serial(backend, params, a_chunk, b_chunk, b_stride, out_chunk, count);
+    }
+}
+
+template<mp_size_t n, const bigint<n>& modulus>
+void Fp_batch<n, modulus>::mul_blocks_serial(const fp_batch_backend backend, const radix_params &params,
+                                             const uint64_t *a, const uint64_t *b, const size_t b_stride,
+                                             uint64_t *out, const size_t num_blocks)
+{
+    switch (backend)
+    {
+#if defined(__x86_64__) && defined(USE_ASM)
+    case fp_batch_backend_avx2:
+        mul_blocks_avx2(params, a, b, b_stride, out, num_blocks);
+        break;
+    case fp_batch_backend_avx512ifma:
+        mul_blocks_avx512ifma(params, a, b, b_stride, out, num_blocks);
+        break;
+#endif
+    default:
+        mul_blocks_scalar(params, a, b, b_stride, out, num_blocks);
+    }
+}
+
+/*
+  All kernels compute the Montgomery product a * b / R_batch mod p of every
+  pair of elements, one radix digit a_i of a at a time: add a_i * b and q * p
+  at digit i, where q makes digit i vanish, and carry digit i into digit i+1.
+  Digits are kept in 64-bit accumulators, digit k in t[k], and only
+  normalized at the end; the product is digits m to 2m-1, followed by one
+  conditional subtraction of p. A block may be multiplied in place, as each
+  lane is only written after it has been read.
+*/
+
+template<mp_size_t n, const bigint<n>& modulus>
+void Fp_batch<n, modulus>::mul_blocks_scalar(const radix_params &params,
+                                             const uint64_t *a, const uint64_t *b, const size_t b_stride,
+                                             uint64_t *out, const size_t num_blocks)
+{
+    const size_t m = params.num_limbs;
+    const size_t radix_bits = params.radix_bits;
+    const uint64_t mask = params.mask;
+    const uint64_t inv = params.inv;
+    const uint64_t *p = params.p.data();
+
+    for (size_t blk = 0; blk < num_blocks; ++blk)
+    {
+        const uint64_t *ab = a + blk * m * block_size;
+        const uint64_t *bb = b + blk * b_stride;
+        uint64_t *ob = out + blk * m * block_size;
+
+        for (size_t l = 0; l < block_size; ++l)
+        {
+            /* digit i + j of the running sum is t[i + j], so nothing needs shifting */
+            uint64_t t[2 * max_limbs_26] = {0};
+            for (size_t i = 0; i < m; ++i)
+            {
+                const uint64_t ai = ab[i * block_size + l];
+                for (size_t j = 0; j < m; ++j)
+                {
+                    t[i + j] += ai * bb[j * block_size + l];
+                }
+
+                const uint64_t q = (t[i] * inv) & mask;
+                for (size_t j = 0; j < m; ++j)
+                {
+                    t[i + j] += q * p[j];
+                }
+                t[i + 1] += t[i] >> radix_bits;
+            }
+
+            uint64_t carry = 0, borrow = 0;
+            uint64_t d[max_limbs_26];
+            for (size_t k = 0; k < m; ++k)
+            {
+                t[m + k] += carry;
+                carry = t[m + k] >> radix_bits;
+                t[m + k] &= mask;
+                d[k] = t[m + k] + (1ull << radix_bits) - p[k] - borrow;
+                borrow = 1 - (d[k] >> radix_bits);
+                d[k] &= mask;
+            }
+            for (size_t k = 0; k < m; ++k)
+            {
+                ob[k * block_size + l] = borrow ? t[m + k] : d[k];
+            }
+        }
+    }
+}
+
+#if defined(__x86_64__) && defined(USE_ASM)
+
+template<mp_size_t n, const bigint<n>& modulus>
+__attribute__((target("avx2")))
+void Fp_batch<n, modulus>::mul_blocks_avx2(const radix_params &params,
+                                           const uint64_t *a, const uint64_t *b, const size_t b_stride,
+                                           uint64_t *out, const size_t num_blocks)
+{
+    const size_t m = params.num_limbs;
+    const __m256i mask = _mm256_set1_epi64x(params.mask);
+    const __m256i inv = _mm256_set1_epi64x(params.inv);
+    const __m256i radix = _mm256_set1_epi64x(1ll << params.radix_bits);
+    const __m256i one = _mm256_set1_epi64x(1);
+    const __m256i zero = _mm256_setzero_si256();
+
+    __m256i p[max_limbs_26];
+    for (size_t j = 0; j < m; ++j)
+    {
+        p[j] = _mm256_set1_epi64x(params.p[j]);
+    }
+
+    /* 4 lanes at a time, so two halves per block */
+    for (size_t half = 0; half < 2 * num_blocks; ++half)
+    {
+        const size_t blk = half / 2;
+        const size_t lane = 4 * (half % 2);
+        const uint64_t *ab = a + blk * m * block_size + lane;
+        const uint64_t *bb = b + blk * b_stride + lane;
+        uint64_t *ob = out + blk * m * block_size + lane;
+
+        __m256i bv[max_limbs_26], t[2 * max_limbs_26];
+        for (size_t j = 0; j < m; ++j)
+        {
+            bv[j] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bb + j * block_size));
+        }
+        for (size_t j = 0; j < 2 * m; ++j)
+        {
+            t[j] = zero;
+        }
+
+        for (size_t i = 0; i < m; ++i)
+        {
+            const __m256i ai = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ab + i * block_size));
+            for (size_t j = 0; j < m; ++j)
+            {
+                t[i + j] = _mm256_add_epi64(t[i + j], _mm256_mul_epu32(ai, bv[j]));
+            }
+
+            const __m256i q = _mm256_and_si256(_mm256_mul_epu32(t[i], inv), mask);
+            for (size_t j = 0; j < m; ++j)
+            {
+                t[i + j] = _mm256_add_epi64(t[i + j], _mm256_mul_epu32(q, p[j]));
+            }
+            t[i + 1] = _mm256_add_epi64(t[i + 1], _mm256_srli_epi64(t[i], params.radix_bits));
+        }
+
+        __m256i carry = zero, borrow = zero;
+        __m256i *r = t + m;
+        __m256i d[max_limbs_26];
+        for (size_t k = 0; k < m; ++k)
+        {
+            r[k] = _mm256_add_epi64(r[k], carry);
+            carry = _mm256_srli_epi64(r[k], params.radix_bits);
+            r[k] = _mm256_and_si256(r[k], mask);
+            d[k] = _mm256_sub_epi64(_mm256_sub_epi64(_mm256_add_epi64(r[k], radix), p[k]), borrow);
+            borrow = _mm256_sub_epi64(one, _mm256_srli_epi64(d[k], params.radix_bits));
+            d[k] = _mm256_and_si256(d[k], mask);
+        }
+
+        /* keep r where r - p borrowed */
+        const __m256i keep_r = _mm256_cmpeq_epi64(borrow, one);
+        for (size_t k = 0; k < m; ++k)
+        {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(ob + k * block_size), _mm256_blendv_epi8(d[k], r[k], keep_r));
+        }
+    }
+}
+
+template<mp_size_t n, const bigint<n>& modulus>
+__attribute__((target("avx512f,avx512ifma")))
+void Fp_batch<n, modulus>::mul_blocks_avx512ifma(const radix_params &params,
+                                                 const uint64_t *a, const uint64_t *b, const size_t b_stride,
+                                                 uint64_t *out, const size_t num_blocks)
+{
+    const size_t m = params.num_limbs;
+    const __m512i mask = _mm512_set1_epi64(params.mask);
+    const __m512i inv = _mm512_set1_epi64(params.inv);
+    const __m512i radix = _mm512_set1_epi64(1ll << params.radix_bits);
+    const __m512i one = _mm512_set1_epi64(1);
+    const __m512i zero = _mm512_setzero_si512();
+    /* masked shifts, as the unmasked ones read an undefined register, which GCC warns about */
+    const __mmask8 all_lanes = 0xff;
+
+    __m512i p[max_limbs_52];
+    for (size_t j = 0; j < m; ++j)
+    {
+        p[j] = _mm512_set1_epi64(params.p[j]);
+    }
+
+    for (size_t blk = 0; blk < num_blocks; ++blk)
+    {
+        const uint64_t *ab = a + blk * m * block_size;
+        const uint64_t *bb = b + blk * b_stride;
+        uint64_t *ob = out + blk * m * block_size;
+
+        /* the 104-bit products are split: low 52 bits into t[i+j], high 52 bits into t[i+j+1] */
+        __m512i bv[max_limbs_52], t[2 * max_limbs_52 + 1];
+        for (size_t j = 0; j < m; ++j)
+        {
+            bv[j] = _mm512_loadu_si512(bb + j * block_size);
+        }
+        for (size_t j = 0; j < 2 * m + 1; ++j)
+        {
+            t[j] = zero;
+        }
+
+        for (size_t i = 0; i < m; ++i)
+        {
+            const __m512i ai = _mm512_loadu_si512(ab + i * block_size);
+            for (size_t j = 0; j < m; ++j)
+            {
+                t[i + j] = _mm512_madd52lo_epu64(t[i + j], ai, bv[j]);
+                t[i + j + 1] = _mm512_madd52hi_epu64(t[i + j + 1], ai, bv[j]);
+            }
+
+            const __m512i q = _mm512_madd52lo_epu64(zero, t[i], inv);
+            for (size_t j = 0; j < m; ++j)
+            {
+                t[i + j] = _mm512_madd52lo_epu64(t[i + j], q, p[j]);
+                t[i + j + 1] = _mm512_madd52hi_epu64(t[i + j + 1], q, p[j]);
+            }
+            t[i + 1] = _mm512_add_epi64(t[i + 1], _mm512_maskz_srli_epi64(all_lanes, t[i], params.radix_bits));
+        }
+
+        __m512i carry = zero, borrow = zero;
+        __m512i *r = t + m;
+        __m512i d[max_limbs_52];
+        for (size_t k = 0; k < m; ++k)
+        {
+            r[k] = _mm512_add_epi64(r[k], carry);
+            carry = _mm512_maskz_srli_epi64(all_lanes, r[k], params.radix_bits);
+            r[k] = _mm512_and_si512(r[k], mask);
+            d[k] = _mm512_sub_epi64(_mm512_sub_epi64(_mm512_add_epi64(r[k], radix), p[k]), borrow);
+            borrow = _mm512_sub_epi64(one, _mm512_maskz_srli_epi64(all_lanes, d[k], params.radix_bits));
+            d[k] = _mm512_and_si512(d[k], mask);
+        }
+
+        /* keep r where r - p borrowed */
+        const __mmask8 keep_r = _mm512_cmpeq_epi64_mask(borrow, one);
+        for (size_t k = 0; k < m; ++k)
+        {
+            _mm512_storeu_si512(ob + k * block_size, _mm512_mask_blend_epi64(keep_r, d[k], r[k]));
+        }
+    }
+}
+
+#endif
+
+} // libff
+
+#endif // FP_BATCH_TCC_
@@ -0,0 +1,41 @@
+/** @file
+ *****************************************************************************
+
+ Declaration of interfaces for hashing byte strings to field elements, as
+ specified in RFC 9380 ("Hashing to Elliptic Curves"), Section 5.
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef HASH_TO_FIELD_HPP_
+#define HASH_TO_FIELD_HPP_
+
+#include <string>
+#include <vector>
+
+namespace libff {
+
+/**
+ * expand_message_xmd instantiated with SHA-256 (RFC 9380, Section 5.3.1).
+ * Returns len_in_bytes uniformly random bytes derived from msg and the domain
+ * separation tag dst.
+ */
+inline std::vector<unsigned char> expand_message_xmd(const std::string &msg, const std::string &dst, const size_t len_in_bytes);
+
+/**
+ * hash_to_field for a prime field FieldT with security parameter k = 128
+ * (RFC 9380, Section 5.2). Returns count elements; elements of an extension of
+ * degree m are obtained by hashing to count*m elements of the base field and
+ * taking consecutive groups of m of them as coefficients.
+ */
+template<typename FieldT>
+std::vector<FieldT> hash_to_field(const std::string &msg, const std::string &dst, const size_t count);
+
+} // libff
+
+#include <libff/algebra/fields/hash_to_field.tcc>
+
+#endif // HASH_TO_FIELD_HPP_
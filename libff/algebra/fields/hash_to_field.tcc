@@ -0,0 +1,102 @@
+/** @file
+ *****************************************************************************
+
+ Implementation of interfaces for hashing byte strings to field elements.
+
+ See hash_to_field.hpp .
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef HASH_TO_FIELD_TCC_
+#define HASH_TO_FIELD_TCC_
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <gmp.h>
+#include <openssl/sha.h>
+
+#include <libff/algebra/fields/bigint.hpp>
+
+namespace libff {
+
+std::vector<unsigned char> expand_message_xmd(const std::string &msg, const std::string &dst, const size_t len_in_bytes)
+{
+    const size_t b_in_bytes = SHA256_DIGEST_LENGTH;
+    const size_t s_in_bytes = SHA256_CBLOCK;
+    const size_t ell = (len_in_bytes + b_in_bytes - 1) / b_in_bytes;
+
+    if (ell > 255 || len_in_bytes > 65535 || dst.size() > 255)
+    {
+        throw std::invalid_argument("expand_message_xmd: requested length or DST too long");
+    }
+
+    /* DST_prime = DST || I2OSP(len(DST), 1) */
+    std::string dst_prime = dst;
+    dst_prime.push_back(static_cast<char>(dst.size()));
+
+    /* msg_prime = Z_pad || msg || I2OSP(len_in_bytes, 2) || I2OSP(0, 1) || DST_prime */
+    std::string msg_prime(s_in_bytes, '\0');
+    msg_prime += msg;
+    msg_prime.push_back(static_cast<char>(len_in_bytes >> 8));
+    msg_prime.push_back(static_cast<char>(len_in_bytes & 0xff));
+    msg_prime.push_back('\0');
+    msg_prime += dst_prime;
+
+    unsigned char b_0[SHA256_DIGEST_LENGTH];
+    SHA256(reinterpret_cast<const unsigned char*>(msg_prime.data()), msg_prime.size(), b_0);
+
+    std::vector<unsigned char> uniform_bytes(ell * b_in_bytes);
+    std::string block(b_in_bytes + 1 + dst_prime.size(), '\0');
+    for (size_t i = 1; i <= ell; ++i)
+    {
+        /* b_1 = H(b_0 || I2OSP(1, 1) || DST_prime), b_i = H(strxor(b_0, b_(i-1)) || I2OSP(i, 1) || DST_prime) */
+        for (size_t j = 0; j < b_in_bytes; ++j)
+        {
+            block[j] = static_cast<char>(i == 1 ? b_0[j] : b_0[j] ^ uniform_bytes[(i-2) * b_in_bytes + j]);
+        }
+        block[b_in_bytes] = static_cast<char>(i);
+        std::copy(dst_prime.begin(), dst_prime.end(), block.begin() + b_in_bytes + 1);
+
+        SHA256(reinterpret_cast<const unsigned char*>(block.data()), block.size(), &uniform_bytes[(i-1) * b_in_bytes]);
+    }
+
+    uniform_bytes.resize(len_in_bytes);
+    return uniform_bytes;
+}
+
+template<typename FieldT>
+std::vector<FieldT> hash_to_field(const std::string &msg, const std::string &dst, const size_t count)
+{
+    /* L = ceil((ceil(log2(p)) + k) / 8) with k = 128 */
+    const size_t L = (FieldT::size_in_bits() + 128 + 7) / 8;
+    const std::vector<unsigned char> uniform_bytes = expand_message_xmd(msg, dst, count * L);
+
+    mpz_t modulus, tv;
+    mpz_init(modulus);
+    mpz_init(tv);
+    FieldT::mod.to_mpz(modulus);
+
+    std::vector<FieldT> result;
+    result.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        /* e_i = OS2IP(uniform_bytes[L*i : L*(i+1)]) mod p */
+        mpz_import(tv, L, 1, 1, 1, 0, &uniform_bytes[L * i]);
+        mpz_mod(tv, tv, modulus);
+        result.emplace_back(FieldT(bigint<FieldT::num_limbs>(tv)));
+    }
+
+    mpz_clear(tv);
+    mpz_clear(modulus);
+
+    return result;
+}
+
+} // libff
+
+#endif // HASH_TO_FIELD_TCC_
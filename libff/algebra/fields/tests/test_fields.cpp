@@ -13,7 +13,11 @@
 #endif
 #include <libff/algebra/curves/alt_bn128/alt_bn128_pp.hpp>
 #include <libff/algebra/fields/fp12_2over3over2.hpp>
+#include <libff/algebra/fields/field_vector_ops.hpp>
+#include <libff/algebra/fields/fp_batch.hpp>
 #include <libff/algebra/fields/fp6_3over2.hpp>
+#include <libff/algebra/scalar_multiplication/multiexp.hpp>
+#include <libff/common/double_batch.hpp>
 
 using namespace libff;
 
@@ -60,6 +64,44 @@ void test_sqrt()
         FieldT asq = a.squared();
         ASSERT(asq.sqrt() == a || asq.sqrt() == -a);
     }
+    ASSERT(FieldT::zero().sqrt() == FieldT::zero());
+}
+
+template<typename FieldT>
+void test_sliding_window_exponent()
+{
+    const FieldT a = FieldT::random_element();
+    const bigint<FieldT::num_limbs> e = FieldT::random_element().as_bigint();
+    const FieldT a_e = power<FieldT>(a, sliding_window_exponent(e, 1)); // plain square-and-multiply
+    for (size_t w = 2; w <= 6; ++w)
+    {
+        ASSERT(power<FieldT>(a, sliding_window_exponent(e, w)) == a_e);
+    }
+    ASSERT((a ^ e) == a_e);
+    ASSERT((a ^ bigint<1>(0ul)) == FieldT::one());
+    ASSERT((a ^ FieldT::euler).squared() == FieldT::one()); // Euler's criterion
+}
+
+template<typename FieldT>
+void test_is_square()
+{
+    const FieldT one = FieldT::one();
+    ASSERT(FieldT::zero().is_square());
+    ASSERT(!FieldT::nqr.is_square());
+
+    FieldT root;
+    ASSERT(!FieldT::nqr.try_sqrt(root));
+
+    for (size_t i = 0; i < 100; ++i)
+    {
+        const FieldT a = FieldT::random_element();
+        ASSERT(a.is_square() == ((a ^ FieldT::euler) == one));
+        ASSERT(a.squared().is_square());
+        ASSERT(!(a.squared() * FieldT::nqr).is_square());
+
+        ASSERT(a.squared().try_sqrt(root));
+        ASSERT(root.squared() == a.squared());
+    }
 }
 
 template<typename FieldT>
@@ -134,6 +176,255 @@ void test_cyclotomic_squaring<Fqk<mnt6_pp> >()
     ASSERT(beta.cyclotomic_squared() == beta.squared());
 }
 
+template<typename FieldT>
+void test_batch_field()
+{
+    typedef typename fp_batch_type<FieldT>::type BatchT;
+
+    const size_t size = 21;
+    std::vector<FieldT> a, b;
+    for (size_t i = 0; i < size; ++i)
+    {
+        a.emplace_back(i == 0 ? FieldT::zero() : FieldT::random_element());
+        b.emplace_back(i == 1 ? -FieldT::one() : FieldT::random_element());
+    }
+    const FieldT c = FieldT::random_element();
+
+    const fp_batch_backend backends[] = { fp_batch_backend_scalar, fp_batch_backend_avx2, fp_batch_backend_avx512ifma };
+    for (const fp_batch_backend backend : backends)
+    {
+        if (!fp_batch_backend_supported(backend))
+        {
+            continue;
+        }
+
+        const BatchT A(a, backend), B(b, backend);
+        ASSERT(A.to_vector() == a);
+
+        const std::vector<FieldT> prod = (A * B).to_vector();
+        const std::vector<FieldT> sq = A.squared().to_vector();
+        const std::vector<FieldT> sum = (A + B).to_vector();
+        const std::vector<FieldT> diff = (A - B).to_vector();
+        const std::vector<FieldT> scaled = (A * c).to_vector();
+        const std::vector<bigint<FieldT::num_limbs> > canonical = A.as_bigints();
+        std::vector<bigint<FieldT::num_limbs> > canonical_direct;
+        BatchT::as_bigints(a.begin(), a.end(), canonical_direct, backend);
+        ASSERT(canonical_direct == canonical);
+        for (size_t i = 0; i < size; ++i)
+        {
+            ASSERT(prod[i] == a[i] * b[i]);
+            ASSERT(sq[i] == a[i].squared());
+            ASSERT(sum[i] == a[i] + b[i]);
+            ASSERT(diff[i] == a[i] - b[i]);
+            ASSERT(scaled[i] == a[i] * c);
+            ASSERT(canonical[i] == a[i].as_bigint());
+            ASSERT(A.get(i) == a[i]);
+        }
+
+        BatchT C(size, backend);
+        C.set(3, c);
+        ASSERT(C.get(3) == c);
+        ASSERT(C.get(4) == FieldT::zero());
+        C *= A;
+        ASSERT(C.get(3) == c * a[3]);
+    }
+}
+
+template<typename FieldT>
+void test_inner_product()
+{
+    const size_t size = 2 * field_vector_block_size + 7;
+    std::vector<FieldT> a, b, c;
+    FieldT dot = FieldT::zero(), count = FieldT::zero();
+    for (size_t i = 0; i < size; ++i)
+    {
+        a.emplace_back(FieldT::random_element());
+        b.emplace_back(FieldT::random_element());
+        c.emplace_back(FieldT::random_element());
+        dot = dot + a[i] * b[i];
+        count = count + FieldT::one();
+    }
+
+    ASSERT(vector_inner_product(a, b) == dot);
+    ASSERT((inner_product<FieldT>(a.begin(), a.end(), b.begin(), b.end()) == dot));
+    ASSERT(vector_inner_product(std::vector<FieldT>(), std::vector<FieldT>()) == FieldT::zero());
+
+    std::vector<FieldT> dots;
+    vector_inner_products(dots, a, std::vector<std::vector<FieldT> >({ b, a, c }));
+    ASSERT(dots.size() == 3);
+    ASSERT(dots[0] == dot);
+    ASSERT(dots[1] == vector_inner_product(a, a));
+    ASSERT(dots[2] == vector_inner_product(c, a));
+
+    /* largest representations, so the unreduced sums carry the most */
+    const std::vector<FieldT> minus_ones(size, -FieldT::one());
+    ASSERT(vector_inner_product(minus_ones, minus_ones) == count);
+}
+
+void test_double_batch(const double_batch_backend backend)
+{
+    const size_t n = 64;
+    std::vector<Double> a, b;
+    for (size_t i = 0; i < n; ++i)
+    {
+        a.emplace_back(Double(std::rand() / (double)RAND_MAX, std::rand() / (double)RAND_MAX));
+        b.emplace_back(Double(std::rand() / (double)RAND_MAX, std::rand() / (double)RAND_MAX));
+    }
+
+    const Double_batch a_batch(a, backend), b_batch(b, backend);
+    const std::vector<Double> sum = (a_batch + b_batch).to_vector();
+    const std::vector<Double> diff = (a_batch - b_batch).to_vector();
+    const std::vector<Double> prod = (a_batch * b_batch).to_vector();
+    for (size_t i = 0; i < n; ++i)
+    {
+        ASSERT(sum[i] == a[i] + b[i]);
+        ASSERT(diff[i] == a[i] - b[i]);
+        ASSERT(prod[i] == a[i] * b[i]);
+    }
+
+    /* against the definition, a[i] = \sum_j a[j] omega^(ij) */
+    const Double omega = get_root_of_unity<Double>(n);
+    Double_batch transformed = a_batch;
+    transformed.FFT();
+    for (size_t i = 0; i < n; ++i)
+    {
+        Double expected = Double::zero();
+        for (size_t j = 0; j < n; ++j)
+        {
+            expected += a[j] * (omega ^ ((i * j) % n));
+        }
+        ASSERT(transformed.get(i) == expected);
+    }
+
+    transformed.iFFT(Double_fft_twiddles(n));
+    for (size_t i = 0; i < n; ++i)
+    {
+        ASSERT(transformed.get(i) == a[i]);
+    }
+}
+
+template<typename FieldT>
+void test_bit_packing()
+{
+    const size_t chunk_bits = FieldT::capacity();
+    bit_vector bits;
+    for (size_t i = 0; i < 3 * chunk_bits + 5; ++i)
+    {
+        bits.push_back(std::rand() % 2);
+    }
+    const packed_bit_vector packed(bits);
+    ASSERT(packed.size() == bits.size());
+    ASSERT(packed.to_bit_vector() == bits);
+
+    /* the bit-at-a-time packing that the word-level kernels replace */
+    std::vector<FieldT> expected;
+    for (size_t i = 0; i * chunk_bits < bits.size(); ++i)
+    {
+        bigint<FieldT::num_limbs> b;
+        for (size_t j = 0; j < chunk_bits && i * chunk_bits + j < bits.size(); ++j)
+        {
+            b.data[j / GMP_NUMB_BITS] |= (bits[i * chunk_bits + j] ? 1ull : 0ull) << (j % GMP_NUMB_BITS);
+        }
+        expected.emplace_back(FieldT(b));
+    }
+    ASSERT(pack_bit_vector_into_field_element_vector<FieldT>(bits) == expected);
+    ASSERT(pack_bit_vector_into_field_element_vector<FieldT>(packed) == expected);
+
+    std::vector<size_t> ints;
+    packed_bit_vector int_bits;
+    for (size_t i = 0; i < 50; ++i)
+    {
+        ints.emplace_back(std::rand() & 0x1fff);
+        int_bits.append_bits(ints.back(), 13);
+    }
+    ASSERT(int_bits.get_bits(13, 13) == ints[1]);
+    ASSERT(pack_int_vector_into_field_element_vector<FieldT>(ints, 13) ==
+           pack_bit_vector_into_field_element_vector<FieldT>(int_bits));
+
+    const FieldT el = FieldT::random_element();
+    const bit_vector el_bits = convert_field_element_to_bit_vector(el);
+    ASSERT(el_bits.size() == FieldT::size_in_bits());
+    for (size_t i = 0; i < el_bits.size(); ++i)
+    {
+        ASSERT(el_bits[i] == el.as_bigint().test_bit(i));
+    }
+    ASSERT(convert_bit_vector_to_field_element<FieldT>(el_bits) == el);
+    ASSERT(convert_field_element_vector_to_bit_vector(std::vector<FieldT>({ el, -el })).size() == 2 * el_bits.size());
+    /* all ones exceeds the modulus */
+    FieldT all_ones = FieldT::zero();
+    for (size_t i = 0; i < FieldT::size_in_bits(); ++i)
+    {
+        all_ones = all_ones + all_ones + FieldT::one();
+    }
+    ASSERT(convert_packed_bit_vector_to_field_element<FieldT>(packed_bit_vector(FieldT::size_in_bits(), true)) == all_ones);
+}
+
+template<typename FieldT>
+void test_field_vector_ops()
+{
+    /* more than two blocks, the last one partial */
+    const size_t size = 2 * field_vector_block_size + 7;
+    std::vector<FieldT> a, b;
+    for (size_t i = 0; i < size; ++i)
+    {
+        a.emplace_back(FieldT::random_element());
+        b.emplace_back(FieldT::random_element());
+    }
+    const FieldT c = FieldT::random_element();
+
+    std::vector<FieldT> sum, diff, prod, sq, scaled;
+    vector_add(sum, a, b);
+    vector_sub(diff, a, b);
+    vector_mul(prod, a, b);
+    vector_mul(sq, a, a);
+    vector_scale(scaled, a, c);
+    for (size_t i = 0; i < size; ++i)
+    {
+        ASSERT(sum[i] == a[i] + b[i]);
+        ASSERT(diff[i] == a[i] - b[i]);
+        ASSERT(prod[i] == a[i] * b[i]);
+        ASSERT(sq[i] == a[i].squared());
+        ASSERT(scaled[i] == c * a[i]);
+    }
+
+    std::vector<FieldT> x = a;
+    vector_add_in_place(x, b);
+    ASSERT(x == sum);
+    vector_sub_in_place(x, b);
+    ASSERT(x == a);
+    vector_mul_in_place(x, b);
+    ASSERT(x == prod);
+    x = a;
+    vector_square_in_place(x);
+    ASSERT(x == sq);
+    x = a;
+    vector_scale_in_place(x, c);
+    ASSERT(x == scaled);
+    x = a;
+    vector_axpy(x, c, b);
+    for (size_t i = 0; i < size; ++i)
+    {
+        ASSERT(x[i] == a[i] + c * b[i]);
+    }
+
+    const std::vector<FieldT> powers = geometric_sequence(c, a[0], size);
+    FieldT acc = c;
+    for (size_t i = 0; i < size; ++i)
+    {
+        ASSERT(powers[i] == acc);
+        acc *= a[0];
+    }
+
+    std::vector<bigint<FieldT::num_limbs> > canonical;
+    vector_as_bigints(canonical, a);
+    for (size_t i = 0; i < size; ++i)
+    {
+        ASSERT(canonical[i] == a[i].as_bigint());
+    }
+    vector_from_bigints(x, canonical);
+    ASSERT(x == a);
+}
+
 template<typename ppT>
 void test_all_fields()
 {
@@ -146,6 +437,21 @@ void test_all_fields()
     test_sqrt<Fq<ppT> >();
     test_sqrt<Fqe<ppT> >();
 
+    test_is_square<Fr<ppT> >();
+    test_is_square<Fq<ppT> >();
+    test_is_square<Fqe<ppT> >();
+
+    test_sliding_window_exponent<Fr<ppT> >();
+    test_sliding_window_exponent<Fq<ppT> >();
+
+    test_batch_field<Fr<ppT> >();
+    test_batch_field<Fq<ppT> >();
+
+    test_field_vector_ops<Fr<ppT> >();
+    test_inner_product<Fr<ppT> >();
+    test_inner_product<Fqe<ppT> >();
+    test_bit_packing<Fr<ppT> >();
+
     test_Frobenius<Fqe<ppT> >();
     test_Frobenius<Fqk<ppT> >();
 
@@ -242,4 +548,7 @@ int main(void)
     test_field<Fr<bn128_pp> >();
     test_field<Fq<bn128_pp> >();
 #endif
+
+    test_double_batch(double_batch_backend_scalar);
+    test_double_batch(double_batch_default_backend());
 }
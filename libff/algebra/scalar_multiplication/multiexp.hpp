@@ -13,8 +13,12 @@
 #define MULTIEXP_HPP_
 
 #include <cstddef>
+#include <cstdint>
+#include <utility>
 #include <vector>
 
+#include <libff/algebra/fields/bigint.hpp>
+
 namespace libff {
 
 enum multi_exp_method {
@@ -43,7 +47,26 @@ enum multi_exp_method {
   * Requires that T implements .dbl() (and, if USE_MIXED_ADDITION is defined,
   * .to_special(), .mixed_add(), and batch_to_special()).
   */
- multi_exp_method_BDLO12
+ multi_exp_method_BDLO12,
+ /**
+  * Straus's interleaved exponentiation ("Addition chains of vectors",
+  * American Mathematical Monthly 71, 1964), with a wNAF of each scalar:
+  * all terms share one chain of doublings. Cheaper than
+  * multi_exp_method_BDLO12 for small inputs (up to a few hundred terms),
+  * whose bucket sums do not pay off.
+  */
+ multi_exp_method_straus
+};
+
+/**
+ * The representation in which multi_exp_method_BDLO12 accumulates its bucket
+ * and window sums of elements of T. It must be constructible from T, and T
+ * from it. Groups with coordinates better suited to long chains of additions
+ * than their own (e.g., edwards_G1) specialize this.
+ */
+template<typename T>
+struct multi_exp_accumulator {
+    typedef T type;
 };
 
 /**
@@ -52,6 +75,11 @@ enum multi_exp_method {
  * using the selected method.
  * Input is split into the given number of chunks, and, when compiled with
  * MULTICORE, the chunks are processed in parallel.
+ *
+ * FieldT is either a field, whose elements are first converted in parallel
+ * with vector_as_bigints, or bigint<n>, for scalars that are already in
+ * canonical form; callers that reuse the same scalars across several
+ * multi-exponentiations can convert them once and pass the bigints.
  */
 template<typename T, typename FieldT, multi_exp_method Method>
 T multi_exp(typename std::vector<T>::const_iterator vec_start,
@@ -61,6 +89,52 @@ T multi_exp(typename std::vector<T>::const_iterator vec_start,
             const size_t chunks);
 
 
+/**
+ * The window size c that multi_exp_method_BDLO12 uses for a chunk of the
+ * given number of scalars.
+ */
+inline size_t get_multi_exp_window_size(const size_t num_scalars);
+
+/**
+ * A vector of scalars recoded into the unsigned c-bit window digits that
+ * multi_exp_method_BDLO12 sorts into buckets. Scalars that are used in
+ * several multi-exponentiations (e.g., a witness against several base
+ * vectors, or in both G1 and G2) can be recoded once and passed to each.
+ *
+ * Digits are stored in 16 bits, so c is at most 16. A b-bit scalar takes
+ * 2*ceil(b/c) bytes: for a 254-bit scalar, 32 bytes at c = 16 (the size of
+ * its bigint) and 52 bytes at c = 10, so recoding trades memory for
+ * skipping the digit extraction in every multi-exponentiation.
+ */
+class multi_exp_recoded_scalars {
+public:
+    size_t window_size;
+    size_t num_scalars;
+    size_t num_windows;
+    /* digits[k * num_scalars + i] is bits [k*c, (k+1)*c) of scalar i, c = window_size */
+    std::vector<uint16_t> digits;
+
+    multi_exp_recoded_scalars() : window_size(0), num_scalars(0), num_windows(0) {}
+    /* FieldT is a field or bigint<n>, as for multi_exp; window_size is at most 16 */
+    template<typename FieldT>
+    multi_exp_recoded_scalars(const std::vector<FieldT> &scalars, const size_t window_size);
+    /* uses get_multi_exp_window_size, capped at 16 */
+    template<typename FieldT>
+    explicit multi_exp_recoded_scalars(const std::vector<FieldT> &scalars);
+
+    size_t digit(const size_t k, const size_t i) const { return digits[k * num_scalars + i]; }
+};
+
+/**
+ * multi_exp_method_BDLO12 on recoded scalars, with their window size.
+ * Input is split into the given number of chunks as for multi_exp.
+ */
+template<typename T>
+T multi_exp(typename std::vector<T>::const_iterator vec_start,
+            typename std::vector<T>::const_iterator vec_end,
+            const multi_exp_recoded_scalars &scalars,
+            const size_t chunks);
+
 /**
  * A variant of multi_exp that takes advantage of the method mixed_add (instead
  * of the operator '+').
@@ -75,8 +149,9 @@ T multi_exp_with_mixed_addition(typename std::vector<T>::const_iterator vec_star
                                 const size_t chunks);
 
 /**
- * A convenience function for calculating a pure inner product, where the
- * more complicated methods are not required.
+ * A convenience function for calculating a pure inner product of field
+ * elements, where the more complicated methods are not required. Uses the
+ * kernel of vector_inner_product (see field_vector_ops.hpp).
  */
 template <typename T>
 T inner_product(typename std::vector<T>::const_iterator a_start,
@@ -110,6 +185,13 @@ T windowed_exp(const size_t scalar_size,
                const window_table<T> &powers_of_g,
                const FieldT &pow);
 
+/* As above, for an exponent already in canonical form. */
+template<typename T, mp_size_t n>
+T windowed_exp(const size_t scalar_size,
+               const size_t window,
+               const window_table<T> &powers_of_g,
+               const bigint<n> &pow_val);
+
 template<typename T, typename FieldT>
 std::vector<T> batch_exp(const size_t scalar_size,
                          const size_t window,
@@ -123,6 +205,30 @@ std::vector<T> batch_exp_with_coeff(const size_t scalar_size,
                                     const FieldT &coeff,
                                     const std::vector<FieldT> &v);
 
+/**
+ * batch_exp in two groups (e.g., G1 and G2 for knowledge commitments) with
+ * the same scalars, in one parallel pass: each block of scalars is
+ * converted to canonical form once and used for both tables, and when the
+ * two windows agree, so are its window digits.
+ */
+template<typename T1, typename T2, typename FieldT>
+std::pair<std::vector<T1>, std::vector<T2> > batch_exp_dual(const size_t scalar_size,
+                                                            const size_t window1,
+                                                            const window_table<T1> &table1,
+                                                            const size_t window2,
+                                                            const window_table<T2> &table2,
+                                                            const std::vector<FieldT> &v);
+
+/* batch_exp_dual of coeff * v[i], multiplying once for both groups */
+template<typename T1, typename T2, typename FieldT>
+std::pair<std::vector<T1>, std::vector<T2> > batch_exp_dual_with_coeff(const size_t scalar_size,
+                                                                       const size_t window1,
+                                                                       const window_table<T1> &table1,
+                                                                       const size_t window2,
+                                                                       const window_table<T2> &table2,
+                                                                       const FieldT &coeff,
+                                                                       const std::vector<FieldT> &v);
+
 template<typename T>
 void batch_to_special(std::vector<T> &vec);
 
@@ -18,11 +18,14 @@
 #include <type_traits>
 
 #include <libff/algebra/fields/bigint.hpp>
+#include <libff/algebra/fields/field_vector_ops.hpp>
 #include <libff/algebra/fields/fp_aux.tcc>
 #include <libff/algebra/scalar_multiplication/multiexp.hpp>
 #include <libff/algebra/scalar_multiplication/wnaf.hpp>
 #include <libff/common/assert.hpp>
+#include <libff/common/huge_pages.hpp>
 #include <libff/common/profiling.hpp>
+#include <libff/common/scratch_arena.hpp>
 #include <libff/common/utils.hpp>
 
 namespace libff {
@@ -105,53 +108,52 @@ public:
 };
 
 /**
- * multi_exp_inner<T, FieldT, Method>() implementes the specified
- * multiexponentiation method.
+ * multi_exp_inner<T, BigIntT, Method>() implementes the specified
+ * multiexponentiation method, on scalars in canonical (bigint) form.
  * this implementation relies on some rather arcane template magic:
  * function templates cannot be partially specialized, so we cannot just write
- *     template<typename T, typename FieldT>
- *     T multi_exp_inner<T, FieldT, multi_exp_method_naive>
+ *     template<typename T, typename BigIntT>
+ *     T multi_exp_inner<T, BigIntT, multi_exp_method_naive>
  * thus we resort to using std::enable_if. the basic idea is that *overloading*
  * is what's actually happening here, it's just that, for any given value of
  * Method, only one of the templates will be valid, and thus the correct
  * implementation will be used.
  */
 
-template<typename T, typename FieldT, multi_exp_method Method,
+template<typename T, typename BigIntT, multi_exp_method Method,
     typename std::enable_if<(Method == multi_exp_method_naive), int>::type = 0>
 T multi_exp_inner(
     typename std::vector<T>::const_iterator vec_start,
     typename std::vector<T>::const_iterator vec_end,
-    typename std::vector<FieldT>::const_iterator scalar_start,
-    typename std::vector<FieldT>::const_iterator scalar_end)
+    typename std::vector<BigIntT>::const_iterator scalar_start,
+    typename std::vector<BigIntT>::const_iterator scalar_end)
 {
     T result(T::zero());
 
     typename std::vector<T>::const_iterator vec_it;
-    typename std::vector<FieldT>::const_iterator scalar_it;
+    typename std::vector<BigIntT>::const_iterator scalar_it;
 
     for (vec_it = vec_start, scalar_it = scalar_start; vec_it != vec_end; ++vec_it, ++scalar_it)
     {
-        bigint<FieldT::num_limbs> scalar_bigint = scalar_it->as_bigint();
-        result = result + opt_window_wnaf_exp(*vec_it, scalar_bigint, scalar_bigint.num_bits());
+        result = result + opt_window_wnaf_exp(*vec_it, *scalar_it, scalar_it->num_bits());
     }
     ASSERT(scalar_it == scalar_end);
 
     return result;
 }
 
-template<typename T, typename FieldT, multi_exp_method Method,
+template<typename T, typename BigIntT, multi_exp_method Method,
     typename std::enable_if<(Method == multi_exp_method_naive_plain), int>::type = 0>
 T multi_exp_inner(
     typename std::vector<T>::const_iterator vec_start,
     typename std::vector<T>::const_iterator vec_end,
-    typename std::vector<FieldT>::const_iterator scalar_start,
-    typename std::vector<FieldT>::const_iterator scalar_end)
+    typename std::vector<BigIntT>::const_iterator scalar_start,
+    typename std::vector<BigIntT>::const_iterator scalar_end)
 {
     T result(T::zero());
 
     typename std::vector<T>::const_iterator vec_it;
-    typename std::vector<FieldT>::const_iterator scalar_it;
+    typename std::vector<BigIntT>::const_iterator scalar_it;
 
     for (vec_it = vec_start, scalar_it = scalar_start; vec_it != vec_end; ++vec_it, ++scalar_it)
     {
@@ -162,40 +164,177 @@ T multi_exp_inner(
     return result;
 }
 
-template<typename T, typename FieldT, multi_exp_method Method,
-    typename std::enable_if<(Method == multi_exp_method_BDLO12), int>::type = 0>
+/* window size of the wNAFs of multi_exp_method_straus */
+const size_t multi_exp_straus_window_size = 4;
+
+template<typename T, typename BigIntT, multi_exp_method Method,
+    typename std::enable_if<(Method == multi_exp_method_straus), int>::type = 0>
 T multi_exp_inner(
-    typename std::vector<T>::const_iterator bases,
-    typename std::vector<T>::const_iterator bases_end,
-    typename std::vector<FieldT>::const_iterator exponents,
-    typename std::vector<FieldT>::const_iterator exponents_end)
+    typename std::vector<T>::const_iterator vec_start,
+    typename std::vector<T>::const_iterator vec_end,
+    typename std::vector<BigIntT>::const_iterator scalar_start,
+    typename std::vector<BigIntT>::const_iterator scalar_end)
 {
-    UNUSED(exponents_end);
-    size_t length = bases_end - bases;
+    UNUSED(scalar_end);
+    const size_t length = vec_end - vec_start;
+    const size_t w = multi_exp_straus_window_size;
+    const size_t table_size = 1ul << (w-1);
+    const scratch_scope scope;
+
+    /* table[i * table_size + j] = (2j+1) * vec_start[i] */
+    scratch_vector<T> table(length * table_size);
+    std::vector<scratch_vector<long> > nafs(length);
+    size_t num_digits = 0;
+    for (size_t i = 0; i < length; ++i)
+    {
+        find_wnaf(nafs[i], w, scalar_start[i]);
+        size_t top = nafs[i].size();
+        while (top > 0 && nafs[i][top-1] == 0)
+        {
+            --top;
+        }
+        num_digits = std::max(num_digits, top);
 
-    // empirically, this seems to be a decent estimate of the optimal value of c
-    size_t log2_length = log2(length);
-    size_t c = log2_length - (log2_length / 3 - 2);
+        const T dbl = vec_start[i].dbl();
+        table[i * table_size] = vec_start[i];
+        for (size_t j = 1; j < table_size; ++j)
+        {
+            table[i * table_size + j] = table[i * table_size + j - 1] + dbl;
+        }
+    }
 
-    const mp_size_t exp_num_limbs =
-        std::remove_reference<decltype(*exponents)>::type::num_limbs;
-    std::vector<bigint<exp_num_limbs> > bn_exponents(length);
-    size_t num_bits = 0;
+    T result = T::zero();
+    for (size_t b = num_digits - 1; b < num_digits; --b)
+    {
+        result = result.dbl();
+        for (size_t i = 0; i < length; ++i)
+        {
+            const long u = (b < nafs[i].size() ? nafs[i][b] : 0);
+            if (u > 0)
+            {
+                result = result + table[i * table_size + u/2];
+            }
+            else if (u < 0)
+            {
+                result = result - table[i * table_size + (-u)/2];
+            }
+        }
+    }
 
-    for (size_t i = 0; i < length; i++)
+    return result;
+}
+
+/**
+ * The bases of a multi-exponentiation, converted once to the accumulator
+ * representation A. When A is T itself, the bases are used in place.
+ */
+template<typename T, typename A = typename multi_exp_accumulator<T>::type>
+class multi_exp_accumulator_bases {
+private:
+    scratch_vector<A> converted;
+public:
+    multi_exp_accumulator_bases(typename std::vector<T>::const_iterator bases,
+                                typename std::vector<T>::const_iterator bases_end)
     {
-        bn_exponents[i] = exponents[i].as_bigint();
-        num_bits = std::max(num_bits, bn_exponents[i].num_bits());
+        converted.reserve(bases_end - bases);
+        for (auto it = bases; it != bases_end; ++it)
+        {
+            converted.emplace_back(A(*it));
+        }
     }
 
-    size_t num_groups = (num_bits + c - 1) / c;
+    const A& operator[](const size_t i) const { return converted[i]; }
+};
 
-    T result;
+template<typename T>
+class multi_exp_accumulator_bases<T, T> {
+private:
+    typename std::vector<T>::const_iterator bases;
+public:
+    multi_exp_accumulator_bases(typename std::vector<T>::const_iterator bases,
+                                typename std::vector<T>::const_iterator bases_end) :
+        bases(bases)
+    {
+        UNUSED(bases_end);
+    }
+
+    const T& operator[](const size_t i) const { return bases[i]; }
+};
+
+/* bits [offset, offset + c) of x */
+template<mp_size_t n>
+size_t multi_exp_window_digit(const bigint<n> &x, const size_t offset, const size_t c)
+{
+    const size_t word = offset / GMP_NUMB_BITS;
+    const size_t shift = offset % GMP_NUMB_BITS;
+    if (word >= n)
+    {
+        return 0;
+    }
+
+    mp_limb_t result = x.data[word] >> shift;
+    if (shift + c > GMP_NUMB_BITS && word + 1 < n)
+    {
+        result |= x.data[word + 1] << (GMP_NUMB_BITS - shift);
+    }
+    return result & ((1ul << c) - 1);
+}
+
+/**
+ * The bucket method of multi_exp_method_BDLO12, over num_groups windows of
+ * c bits; digit(k, i) is the k-th window of the i-th scalar.
+ *
+ * If window_sums is given, the windows are not combined: the sum of window k,
+ * \sum_i digit(k, i) * bases[i], is stored in (*window_sums)[k] instead, and
+ * the return value is meaningless.
+ */
+template<typename T, typename DigitF>
+T multi_exp_BDLO12_buckets(typename std::vector<T>::const_iterator bases,
+                           typename std::vector<T>::const_iterator bases_end,
+                           const size_t c,
+                           const size_t num_groups,
+                           const DigitF &digit,
+                           std::vector<T> *window_sums = nullptr)
+{
+    size_t length = bases_end - bases;
+    const scratch_scope scope;
+
+    typedef typename multi_exp_accumulator<T>::type A;
+#ifndef USE_MIXED_ADDITION
+    const multi_exp_accumulator_bases<T> acc_bases(bases, bases_end);
+#endif
+
+    A result;
     bool result_nonzero = false;
 
+#ifdef USE_MIXED_ADDITION
+    /* batch_to_special takes a std::vector, so these cannot come from the arena */
+    std::vector<A> buckets;
+    if (huge_pages != huge_pages_off)
+    {
+        resize_with_huge_pages(buckets, 1 << c, 1);
+    }
+    else
+    {
+        buckets.resize(1 << c);
+    }
+#else
+    scratch_vector<A> buckets(1 << c);
+#endif
+    std::vector<bool, scratch_allocator<bool> > bucket_nonzero(1 << c);
+
+    if (window_sums != nullptr)
+    {
+        window_sums->assign(num_groups, T::zero());
+    }
+
     for (size_t k = num_groups - 1; k <= num_groups; k--)
     {
-        if (result_nonzero)
+        if (window_sums != nullptr)
+        {
+            result_nonzero = false;
+        }
+        else if (result_nonzero)
         {
             for (size_t i = 0; i < c; i++)
             {
@@ -203,19 +342,11 @@ T multi_exp_inner(
             }
         }
 
-        std::vector<T> buckets(1 << c);
-        std::vector<bool> bucket_nonzero(1 << c);
+        std::fill(bucket_nonzero.begin(), bucket_nonzero.end(), false);
 
         for (size_t i = 0; i < length; i++)
         {
-            size_t id = 0;
-            for (size_t j = 0; j < c; j++)
-            {
-                if (bn_exponents[i].test_bit(k*c + j))
-                {
-                    id |= 1 << j;
-                }
-            }
+            const size_t id = digit(k, i);
 
             if (id == 0)
             {
@@ -227,12 +358,16 @@ T multi_exp_inner(
 #ifdef USE_MIXED_ADDITION
                 buckets[id] = buckets[id].mixed_add(bases[i]);
 #else
-                buckets[id] = buckets[id] + bases[i];
+                buckets[id] = buckets[id] + acc_bases[i];
 #endif
             }
             else
             {
-                buckets[id] = bases[i];
+#ifdef USE_MIXED_ADDITION
+                buckets[id] = A(bases[i]);
+#else
+                buckets[id] = acc_bases[i];
+#endif
                 bucket_nonzero[id] = true;
             }
         }
@@ -241,7 +376,7 @@ T multi_exp_inner(
         batch_to_special(buckets);
 #endif
 
-        T running_sum;
+        A running_sum;
         bool running_sum_nonzero = false;
 
         for (size_t i = (1u << c) - 1; i > 0; i--)
@@ -276,20 +411,52 @@ T multi_exp_inner(
                 }
             }
         }
+
+        if (window_sums != nullptr && result_nonzero)
+        {
+            (*window_sums)[k] = T(result);
+        }
     }
 
-    return result;
+    return (result_nonzero ? T(result) : T::zero());
+}
+
+template<typename T, typename BigIntT, multi_exp_method Method,
+    typename std::enable_if<(Method == multi_exp_method_BDLO12), int>::type = 0>
+T multi_exp_inner(
+    typename std::vector<T>::const_iterator bases,
+    typename std::vector<T>::const_iterator bases_end,
+    typename std::vector<BigIntT>::const_iterator exponents,
+    typename std::vector<BigIntT>::const_iterator exponents_end)
+{
+    UNUSED(exponents_end);
+    const size_t length = bases_end - bases;
+    const size_t c = get_multi_exp_window_size(length);
+
+    size_t num_bits = 0;
+
+    for (size_t i = 0; i < length; i++)
+    {
+        num_bits = std::max(num_bits, exponents[i].num_bits());
+    }
+
+    const size_t num_groups = (num_bits + c - 1) / c;
+
+    return multi_exp_BDLO12_buckets<T>(bases, bases_end, c, num_groups,
+                                       [&](const size_t k, const size_t i) {
+                                           return multi_exp_window_digit(exponents[i], k * c, c);
+                                       });
 }
 
-template<typename T, typename FieldT, multi_exp_method Method,
+template<typename T, typename BigIntT, multi_exp_method Method,
     typename std::enable_if<(Method == multi_exp_method_bos_coster), int>::type = 0>
 T multi_exp_inner(
     typename std::vector<T>::const_iterator vec_start,
     typename std::vector<T>::const_iterator vec_end,
-    typename std::vector<FieldT>::const_iterator scalar_start,
-    typename std::vector<FieldT>::const_iterator scalar_end)
+    typename std::vector<BigIntT>::const_iterator scalar_start,
+    typename std::vector<BigIntT>::const_iterator scalar_end)
 {
-    const mp_size_t n = std::remove_reference<decltype(*scalar_start)>::type::num_limbs;
+    const mp_size_t n = BigIntT::N;
 
     if (vec_start == vec_end)
     {
@@ -301,21 +468,22 @@ T multi_exp_inner(
         return (*scalar_start)*(*vec_start);
     }
 
-    std::vector<ordered_exponent<n> > opt_q;
+    const scratch_scope scope;
+    scratch_vector<ordered_exponent<n> > opt_q;
     const size_t vec_len = scalar_end - scalar_start;
     const size_t odd_vec_len = (vec_len % 2 == 1 ? vec_len : vec_len + 1);
     opt_q.reserve(odd_vec_len);
-    std::vector<T> g;
+    scratch_vector<T> g;
     g.reserve(odd_vec_len);
 
     typename std::vector<T>::const_iterator vec_it;
-    typename std::vector<FieldT>::const_iterator scalar_it;
+    typename std::vector<BigIntT>::const_iterator scalar_it;
     size_t i;
     for (i=0, vec_it = vec_start, scalar_it = scalar_start; vec_it != vec_end; ++vec_it, ++scalar_it, ++i)
     {
         g.emplace_back(*vec_it);
 
-        opt_q.emplace_back(ordered_exponent<n>(i, scalar_it->as_bigint()));
+        opt_q.emplace_back(ordered_exponent<n>(i, *scalar_it));
     }
     std::make_heap(opt_q.begin(),opt_q.end());
     ASSERT(scalar_it == scalar_end);
@@ -399,6 +567,56 @@ T multi_exp_inner(
     return opt_result;
 }
 
+/**
+ * The scalars of a multi-exponentiation in canonical form. Field elements
+ * are converted once, in parallel, before any chunk starts; scalars that are
+ * already bigints are used in place.
+ */
+template<typename FieldT>
+class multi_exp_canonical_scalars {
+public:
+    typedef bigint<FieldT::num_limbs> bigint_type;
+private:
+    std::vector<bigint_type> converted;
+public:
+    multi_exp_canonical_scalars(typename std::vector<FieldT>::const_iterator scalar_start,
+                                typename std::vector<FieldT>::const_iterator scalar_end)
+    {
+        vector_as_bigints<FieldT>(converted, scalar_start, scalar_end);
+    }
+
+    typename std::vector<bigint_type>::const_iterator begin() const { return converted.begin(); }
+};
+
+template<mp_size_t n>
+class multi_exp_canonical_scalars<bigint<n> > {
+public:
+    typedef bigint<n> bigint_type;
+private:
+    typename std::vector<bigint_type>::const_iterator scalar_start;
+public:
+    multi_exp_canonical_scalars(typename std::vector<bigint_type>::const_iterator scalar_start,
+                                typename std::vector<bigint_type>::const_iterator scalar_end) :
+        scalar_start(scalar_start)
+    {
+        UNUSED(scalar_end);
+    }
+
+    typename std::vector<bigint_type>::const_iterator begin() const { return scalar_start; }
+};
+
+template<typename FieldT>
+bool multi_exp_scalar_is_one(const FieldT &scalar)
+{
+    return scalar == FieldT::one();
+}
+
+template<mp_size_t n>
+bool multi_exp_scalar_is_one(const bigint<n> &scalar)
+{
+    return scalar == bigint<n>(1ul);
+}
+
 template<typename T, typename FieldT, multi_exp_method Method>
 T multi_exp(typename std::vector<T>::const_iterator vec_start,
             typename std::vector<T>::const_iterator vec_end,
@@ -406,28 +624,34 @@ T multi_exp(typename std::vector<T>::const_iterator vec_start,
             typename std::vector<FieldT>::const_iterator scalar_end,
             const size_t chunks)
 {
+    typedef typename multi_exp_canonical_scalars<FieldT>::bigint_type BigIntT;
+    const multi_exp_canonical_scalars<FieldT> scalars(scalar_start, scalar_end);
+    const typename std::vector<BigIntT>::const_iterator bn_start = scalars.begin();
+    const typename std::vector<BigIntT>::const_iterator bn_end = bn_start + (scalar_end - scalar_start);
+
     const size_t total = vec_end - vec_start;
     if ((total < chunks) || (chunks == 1))
     {
         // no need to split into "chunks", can call implementation directly
-        return multi_exp_inner<T, FieldT, Method>(
-            vec_start, vec_end, scalar_start, scalar_end);
+        return multi_exp_inner<T, BigIntT, Method>(
+            vec_start, vec_end, bn_start, bn_end);
     }
 
     const size_t one = total/chunks;
 
-    std::vector<T> partial(chunks, T::zero());
+    const scratch_scope scope;
+    scratch_vector<T> partial(chunks, T::zero());
 
 #ifdef MULTICORE
 #pragma omp parallel for
 #endif
     for (size_t i = 0; i < chunks; ++i)
     {
-        partial[i] = multi_exp_inner<T, FieldT, Method>(
+        partial[i] = multi_exp_inner<T, BigIntT, Method>(
              vec_start + i*one,
              (i == chunks-1 ? vec_end : vec_start + (i+1)*one),
-             scalar_start + i*one,
-             (i == chunks-1 ? scalar_end : scalar_start + (i+1)*one));
+             bn_start + i*one,
+             (i == chunks-1 ? bn_end : bn_start + (i+1)*one));
     }
 
     T final = T::zero();
@@ -440,6 +664,88 @@ T multi_exp(typename std::vector<T>::const_iterator vec_start,
     return final;
 }
 
+size_t get_multi_exp_window_size(const size_t num_scalars)
+{
+    // empirically, this seems to be a decent estimate of the optimal value of c
+    const size_t log2_length = log2(num_scalars);
+    return log2_length - (log2_length / 3 - 2);
+}
+
+template<typename FieldT>
+multi_exp_recoded_scalars::multi_exp_recoded_scalars(const std::vector<FieldT> &scalars, const size_t window_size) :
+    window_size(window_size), num_scalars(scalars.size())
+{
+    ASSERT(window_size > 0 && window_size <= 16);
+
+    typedef typename multi_exp_canonical_scalars<FieldT>::bigint_type BigIntT;
+    const multi_exp_canonical_scalars<FieldT> canonical(scalars.begin(), scalars.end());
+    const typename std::vector<BigIntT>::const_iterator bn = canonical.begin();
+
+    size_t num_bits = 0;
+    for (size_t i = 0; i < this->num_scalars; ++i)
+    {
+        num_bits = std::max(num_bits, bn[i].num_bits());
+    }
+    this->num_windows = (num_bits + window_size - 1) / window_size;
+
+    this->digits.resize(this->num_windows * this->num_scalars);
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+    for (size_t i = 0; i < this->num_scalars; ++i)
+    {
+        for (size_t k = 0; k < this->num_windows; ++k)
+        {
+            this->digits[k * this->num_scalars + i] = static_cast<uint16_t>(multi_exp_window_digit(bn[i], k * window_size, window_size));
+        }
+    }
+}
+
+template<typename FieldT>
+multi_exp_recoded_scalars::multi_exp_recoded_scalars(const std::vector<FieldT> &scalars) :
+    multi_exp_recoded_scalars(scalars, std::min<size_t>(get_multi_exp_window_size(scalars.size()), 16))
+{
+}
+
+template<typename T>
+T multi_exp(typename std::vector<T>::const_iterator vec_start,
+            typename std::vector<T>::const_iterator vec_end,
+            const multi_exp_recoded_scalars &scalars,
+            const size_t chunks)
+{
+    const size_t total = vec_end - vec_start;
+    ASSERT(total == scalars.num_scalars);
+    const size_t num_chunks = ((total < chunks) ? 1 : chunks);
+    const size_t one = total/num_chunks;
+
+    const scratch_scope scope;
+    scratch_vector<T> partial(num_chunks, T::zero());
+
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+    for (size_t i = 0; i < num_chunks; ++i)
+    {
+        const size_t offset = i*one;
+        partial[i] = multi_exp_BDLO12_buckets<T>(
+            vec_start + offset,
+            (i == num_chunks-1 ? vec_end : vec_start + (i+1)*one),
+            scalars.window_size, scalars.num_windows,
+            [&](const size_t k, const size_t j) {
+                return scalars.digit(k, offset + j);
+            });
+    }
+
+    T final = T::zero();
+
+    for (size_t i = 0; i < num_chunks; ++i)
+    {
+        final = final + partial[i];
+    }
+
+    return final;
+}
+
 template<typename T, typename FieldT, multi_exp_method Method>
 T multi_exp_with_mixed_addition(typename std::vector<T>::const_iterator vec_start,
                                 typename std::vector<T>::const_iterator vec_end,
@@ -452,8 +758,6 @@ T multi_exp_with_mixed_addition(typename std::vector<T>::const_iterator vec_star
     auto value_it = vec_start;
     auto scalar_it = scalar_start;
 
-    const FieldT zero = FieldT::zero();
-    const FieldT one = FieldT::one();
     std::vector<FieldT> p;
     std::vector<T> g;
 
@@ -465,12 +769,12 @@ T multi_exp_with_mixed_addition(typename std::vector<T>::const_iterator vec_star
 
     for (; scalar_it != scalar_end; ++scalar_it, ++value_it)
     {
-        if (*scalar_it == zero)
+        if (scalar_it->is_zero())
         {
             // do nothing
             ++num_skip;
         }
-        else if (*scalar_it == one)
+        else if (multi_exp_scalar_is_one(*scalar_it))
         {
 #ifdef USE_MIXED_ADDITION
             acc = acc.mixed_add(*value_it);
@@ -501,9 +805,16 @@ T inner_product(typename std::vector<T>::const_iterator a_start,
                 typename std::vector<T>::const_iterator b_start,
                 typename std::vector<T>::const_iterator b_end)
 {
-    return multi_exp<T, T, multi_exp_method_naive_plain>(
-        a_start, a_end,
-        b_start, b_end, 1);
+    ASSERT(a_end - a_start == b_end - b_start);
+    const size_t size = a_end - a_start;
+    if (size == 0)
+    {
+        return T::zero();
+    }
+
+    std::vector<T> result;
+    field_vector_inner_products(result, &*a_start, std::vector<const T*>(1, &*b_start), size);
+    return result[0];
 }
 
 template<typename T>
@@ -559,7 +870,20 @@ window_table<T> get_window_table(const size_t scalar_size,
     }
 #endif
 
-    window_table<T> powers_of_g(outerc, std::vector<T>(in_window, T::zero()));
+    window_table<T> powers_of_g;
+    if (huge_pages == huge_pages_off)
+    {
+        powers_of_g.assign(outerc, std::vector<T>(in_window, T::zero()));
+    }
+    else
+    {
+        powers_of_g.resize(outerc);
+        for (std::vector<T> &row : powers_of_g)
+        {
+            resize_with_huge_pages(row, in_window, 1);
+            std::fill(row.begin(), row.end(), T::zero());
+        }
+    }
 
     T gouter = g;
 
@@ -587,9 +911,17 @@ T windowed_exp(const size_t scalar_size,
                const size_t window,
                const window_table<T> &powers_of_g,
                const FieldT &pow)
+{
+    return windowed_exp(scalar_size, window, powers_of_g, pow.as_bigint());
+}
+
+template<typename T, mp_size_t n>
+T windowed_exp(const size_t scalar_size,
+               const size_t window,
+               const window_table<T> &powers_of_g,
+               const bigint<n> &pow_val)
 {
     const size_t outerc = (scalar_size+window-1)/window;
-    const bigint<FieldT::num_limbs> pow_val = pow.as_bigint();
 
     /* exp */
     T res = powers_of_g[0][0];
@@ -680,37 +1012,121 @@ std::vector<T> batch_exp_with_coeff(const size_t scalar_size,
     return res;
 }
 
-template<typename T>
-void batch_to_special(std::vector<T> &vec)
+template<typename T1, typename T2, typename FieldT>
+std::pair<std::vector<T1>, std::vector<T2> > batch_exp_dual_inner(const size_t scalar_size,
+                                                                  const size_t window1,
+                                                                  const window_table<T1> &table1,
+                                                                  const size_t window2,
+                                                                  const window_table<T2> &table2,
+                                                                  const FieldT *coeff,
+                                                                  const std::vector<FieldT> &v)
 {
-    enter_block("Batch-convert elements to special form");
+    typedef bigint<FieldT::num_limbs> BigIntT;
 
-    std::vector<T> non_zero_vec;
-    for (size_t i = 0; i < vec.size(); ++i)
+    if (!inhibit_profiling_info)
     {
-        if (!vec[i].is_zero())
-        {
-            non_zero_vec.emplace_back(vec[i]);
-        }
+        print_indent();
     }
+    std::pair<std::vector<T1>, std::vector<T2> > res(std::vector<T1>(v.size(), table1[0][0]),
+                                                     std::vector<T2>(v.size(), table2[0][0]));
 
-    T::batch_to_special_all_non_zeros(non_zero_vec);
-    auto it = non_zero_vec.begin();
-    T zero_special = T::zero();
-    zero_special.to_special();
+    const size_t outerc1 = (scalar_size+window1-1)/window1;
+    const size_t outerc2 = (scalar_size+window2-1)/window2;
+    const size_t num_blocks = (v.size() + field_vector_block_size - 1) / field_vector_block_size;
 
-    for (size_t i = 0; i < vec.size(); ++i)
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+    for (size_t b = 0; b < num_blocks; ++b)
     {
-        if (!vec[i].is_zero())
+        const size_t begin = b * field_vector_block_size;
+        const size_t end = std::min(v.size(), begin + field_vector_block_size);
+
+        std::vector<FieldT> scaled;
+        if (coeff != nullptr)
         {
-            vec[i] = *it;
-            ++it;
+            scaled.resize(end - begin);
+            for (size_t i = begin; i < end; ++i)
+            {
+                scaled[i - begin] = (*coeff) * v[i];
+            }
+        }
+        std::vector<BigIntT> bn;
+        if (coeff != nullptr)
+        {
+            vector_as_bigints<FieldT>(bn, scaled.cbegin(), scaled.cend());
         }
         else
         {
-            vec[i] = zero_special;
+            vector_as_bigints<FieldT>(bn, v.cbegin() + begin, v.cbegin() + end);
         }
+
+        std::vector<size_t> digits(outerc1);
+        for (size_t i = begin; i < end; ++i)
+        {
+            const BigIntT &pow_val = bn[i - begin];
+
+            T1 res1 = table1[0][0];
+            for (size_t outer = 0; outer < outerc1; ++outer)
+            {
+                digits[outer] = multi_exp_window_digit(pow_val, outer*window1, window1);
+                res1 = res1 + table1[outer][digits[outer]];
+            }
+            res.first[i] = res1;
+
+            T2 res2 = table2[0][0];
+            for (size_t outer = 0; outer < outerc2; ++outer)
+            {
+                const size_t inner = (window1 == window2 ? digits[outer] :
+                                      multi_exp_window_digit(pow_val, outer*window2, window2));
+                res2 = res2 + table2[outer][inner];
+            }
+            res.second[i] = res2;
+
+            if (!inhibit_profiling_info && (i % 10000 == 0))
+            {
+                printf(".");
+                fflush(stdout);
+            }
+        }
+    }
+
+    if (!inhibit_profiling_info)
+    {
+        printf(" DONE!\n");
     }
+
+    return res;
+}
+
+template<typename T1, typename T2, typename FieldT>
+std::pair<std::vector<T1>, std::vector<T2> > batch_exp_dual(const size_t scalar_size,
+                                                            const size_t window1,
+                                                            const window_table<T1> &table1,
+                                                            const size_t window2,
+                                                            const window_table<T2> &table2,
+                                                            const std::vector<FieldT> &v)
+{
+    return batch_exp_dual_inner<T1, T2, FieldT>(scalar_size, window1, table1, window2, table2, nullptr, v);
+}
+
+template<typename T1, typename T2, typename FieldT>
+std::pair<std::vector<T1>, std::vector<T2> > batch_exp_dual_with_coeff(const size_t scalar_size,
+                                                                       const size_t window1,
+                                                                       const window_table<T1> &table1,
+                                                                       const size_t window2,
+                                                                       const window_table<T2> &table2,
+                                                                       const FieldT &coeff,
+                                                                       const std::vector<FieldT> &v)
+{
+    return batch_exp_dual_inner<T1, T2, FieldT>(scalar_size, window1, table1, window2, table2, &coeff, v);
+}
+
+template<typename T>
+void batch_to_special(std::vector<T> &vec)
+{
+    enter_block("Batch-convert elements to special form");
+    T::batch_to_special(vec);
     leave_block("Batch-convert elements to special form");
 }
 
@@ -0,0 +1,77 @@
+/** @file
+ *****************************************************************************
+
+ Declaration of asynchronous variants of the multi-exponentiation routines.
+
+ Each function queues its synchronous counterpart (see multiexp.hpp) on
+ task_scheduler::global() with the given priority and returns a future for
+ the result. Inputs are taken by reference or iterator, not copied: they
+ must stay alive and unmodified until the future is ready. Unlike those of
+ std::async, the returned futures do not wait for the task when destroyed,
+ so wait on them before the inputs go away.
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef MULTIEXP_ASYNC_HPP_
+#define MULTIEXP_ASYNC_HPP_
+
+#include <future>
+#include <vector>
+
+#include <libff/algebra/scalar_multiplication/multiexp.hpp>
+#include <libff/common/task_scheduler.hpp>
+
+namespace libff {
+
+template<typename T, typename FieldT, multi_exp_method Method>
+std::future<T> multi_exp_async(typename std::vector<T>::const_iterator vec_start,
+                               typename std::vector<T>::const_iterator vec_end,
+                               typename std::vector<FieldT>::const_iterator scalar_start,
+                               typename std::vector<FieldT>::const_iterator scalar_end,
+                               const size_t chunks,
+                               const task_priority priority = task_priority_normal);
+
+template<typename T>
+std::future<T> multi_exp_async(typename std::vector<T>::const_iterator vec_start,
+                               typename std::vector<T>::const_iterator vec_end,
+                               const multi_exp_recoded_scalars &scalars,
+                               const size_t chunks,
+                               const task_priority priority = task_priority_normal);
+
+template<typename T, typename FieldT, multi_exp_method Method>
+std::future<T> multi_exp_with_mixed_addition_async(typename std::vector<T>::const_iterator vec_start,
+                                                   typename std::vector<T>::const_iterator vec_end,
+                                                   typename std::vector<FieldT>::const_iterator scalar_start,
+                                                   typename std::vector<FieldT>::const_iterator scalar_end,
+                                                   const size_t chunks,
+                                                   const task_priority priority = task_priority_normal);
+
+template<typename T, typename FieldT>
+std::future<std::vector<T> > batch_exp_async(const size_t scalar_size,
+                                             const size_t window,
+                                             const window_table<T> &table,
+                                             const std::vector<FieldT> &v,
+                                             const task_priority priority = task_priority_normal);
+
+template<typename T, typename FieldT>
+std::future<std::vector<T> > batch_exp_with_coeff_async(const size_t scalar_size,
+                                                        const size_t window,
+                                                        const window_table<T> &table,
+                                                        const FieldT &coeff,
+                                                        const std::vector<FieldT> &v,
+                                                        const task_priority priority = task_priority_normal);
+
+/* vec is converted in place; it must not be accessed until the future is ready */
+template<typename T>
+std::future<void> batch_to_special_async(std::vector<T> &vec,
+                                         const task_priority priority = task_priority_normal);
+
+} // libff
+
+#include <libff/algebra/scalar_multiplication/multiexp_async.tcc>
+
+#endif // MULTIEXP_ASYNC_HPP_
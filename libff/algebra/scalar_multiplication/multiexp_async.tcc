@@ -0,0 +1,100 @@
+/** @file
+ *****************************************************************************
+
+ Implementation of asynchronous variants of the multi-exponentiation
+ routines.
+
+ See multiexp_async.hpp .
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef MULTIEXP_ASYNC_TCC_
+#define MULTIEXP_ASYNC_TCC_
+
+namespace libff {
+
+template<typename T, typename FieldT, multi_exp_method Method>
+std::future<T> multi_exp_async(typename std::vector<T>::const_iterator vec_start,
+                               typename std::vector<T>::const_iterator vec_end,
+                               typename std::vector<FieldT>::const_iterator scalar_start,
+                               typename std::vector<FieldT>::const_iterator scalar_end,
+                               const size_t chunks,
+                               const task_priority priority)
+{
+    return task_scheduler::global().submit([=]() {
+        return multi_exp<T, FieldT, Method>(vec_start, vec_end, scalar_start, scalar_end, chunks);
+    }, priority);
+}
+
+template<typename T>
+std::future<T> multi_exp_async(typename std::vector<T>::const_iterator vec_start,
+                               typename std::vector<T>::const_iterator vec_end,
+                               const multi_exp_recoded_scalars &scalars,
+                               const size_t chunks,
+                               const task_priority priority)
+{
+    const multi_exp_recoded_scalars *scalars_ptr = &scalars;
+    return task_scheduler::global().submit([=]() {
+        return multi_exp<T>(vec_start, vec_end, *scalars_ptr, chunks);
+    }, priority);
+}
+
+template<typename T, typename FieldT, multi_exp_method Method>
+std::future<T> multi_exp_with_mixed_addition_async(typename std::vector<T>::const_iterator vec_start,
+                                                   typename std::vector<T>::const_iterator vec_end,
+                                                   typename std::vector<FieldT>::const_iterator scalar_start,
+                                                   typename std::vector<FieldT>::const_iterator scalar_end,
+                                                   const size_t chunks,
+                                                   const task_priority priority)
+{
+    return task_scheduler::global().submit([=]() {
+        return multi_exp_with_mixed_addition<T, FieldT, Method>(vec_start, vec_end, scalar_start, scalar_end, chunks);
+    }, priority);
+}
+
+template<typename T, typename FieldT>
+std::future<std::vector<T> > batch_exp_async(const size_t scalar_size,
+                                             const size_t window,
+                                             const window_table<T> &table,
+                                             const std::vector<FieldT> &v,
+                                             const task_priority priority)
+{
+    const window_table<T> *table_ptr = &table;
+    const std::vector<FieldT> *v_ptr = &v;
+    return task_scheduler::global().submit([=]() {
+        return batch_exp<T, FieldT>(scalar_size, window, *table_ptr, *v_ptr);
+    }, priority);
+}
+
+template<typename T, typename FieldT>
+std::future<std::vector<T> > batch_exp_with_coeff_async(const size_t scalar_size,
+                                                        const size_t window,
+                                                        const window_table<T> &table,
+                                                        const FieldT &coeff,
+                                                        const std::vector<FieldT> &v,
+                                                        const task_priority priority)
+{
+    const window_table<T> *table_ptr = &table;
+    const std::vector<FieldT> *v_ptr = &v;
+    return task_scheduler::global().submit([=]() {
+        return batch_exp_with_coeff<T, FieldT>(scalar_size, window, *table_ptr, coeff, *v_ptr);
+    }, priority);
+}
+
+template<typename T>
+std::future<void> batch_to_special_async(std::vector<T> &vec,
+                                         const task_priority priority)
+{
+    std::vector<T> *vec_ptr = &vec;
+    return task_scheduler::global().submit([=]() {
+        batch_to_special<T>(*vec_ptr);
+    }, priority);
+}
+
+} // libff
+
+#endif // MULTIEXP_ASYNC_TCC_
@@ -0,0 +1,69 @@
+/** @file
+ *****************************************************************************
+
+ Declaration of an incrementally updated multi-exponentiation, for
+ commitments \sum_i scalars[i] * bases[i] whose scalars change a few at a
+ time (e.g., vector commitments to account states).
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef MULTIEXP_INCREMENTAL_HPP_
+#define MULTIEXP_INCREMENTAL_HPP_
+
+#include <vector>
+
+#include <libff/algebra/scalar_multiplication/multiexp.hpp>
+
+namespace libff {
+
+/**
+ * Holds the bases and the current value of \sum_i scalars[i] * bases[i].
+ * The scalars themselves are not stored: each update names the index, its
+ * old scalar and its new one, and a batch of updates moves the value by
+ * \sum (new - old) * bases[index], a multi-exponentiation of the size of the
+ * batch rather than of the vector. Batches below straus_threshold terms use
+ * multi_exp_method_straus, larger ones multi_exp_method_BDLO12.
+ *
+ * FieldT is the scalar field of T.
+ */
+template<typename T, typename FieldT>
+class multi_exp_incremental {
+public:
+    struct update {
+        size_t index;
+        FieldT old_value;
+        FieldT new_value;
+    };
+
+    static const size_t straus_threshold = 256;
+
+    /* all scalars zero */
+    explicit multi_exp_incremental(const std::vector<T> &bases);
+    multi_exp_incremental(const std::vector<T> &bases,
+                          const std::vector<FieldT> &scalars,
+                          const size_t chunks = 1);
+
+    const std::vector<T>& bases() const { return this->bases_; }
+    const T& value() const { return this->value_; }
+
+    /**
+     * Applies the updates of one batch; an index may appear more than once,
+     * as long as the old and new scalars of its updates chain up.
+     */
+    void apply(const std::vector<update> &updates, const size_t chunks = 1);
+    void apply(const size_t index, const FieldT &old_value, const FieldT &new_value);
+
+private:
+    std::vector<T> bases_;
+    T value_;
+};
+
+} // libff
+
+#include <libff/algebra/scalar_multiplication/multiexp_incremental.tcc>
+
+#endif // MULTIEXP_INCREMENTAL_HPP_
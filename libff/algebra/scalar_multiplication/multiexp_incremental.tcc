@@ -0,0 +1,83 @@
+/** @file
+ *****************************************************************************
+
+ Implementation of an incrementally updated multi-exponentiation.
+
+ See multiexp_incremental.hpp .
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef MULTIEXP_INCREMENTAL_TCC_
+#define MULTIEXP_INCREMENTAL_TCC_
+
+#include <libff/common/assert.hpp>
+
+namespace libff {
+
+template<typename T, typename FieldT>
+multi_exp_incremental<T, FieldT>::multi_exp_incremental(const std::vector<T> &bases) :
+    bases_(bases), value_(T::zero())
+{
+}
+
+template<typename T, typename FieldT>
+multi_exp_incremental<T, FieldT>::multi_exp_incremental(const std::vector<T> &bases,
+                                                        const std::vector<FieldT> &scalars,
+                                                        const size_t chunks) :
+    bases_(bases)
+{
+    ASSERT(bases.size() == scalars.size());
+    this->value_ = multi_exp<T, FieldT, multi_exp_method_BDLO12>(
+        this->bases_.cbegin(), this->bases_.cend(), scalars.cbegin(), scalars.cend(), chunks);
+}
+
+template<typename T, typename FieldT>
+void multi_exp_incremental<T, FieldT>::apply(const std::vector<update> &updates, const size_t chunks)
+{
+    std::vector<T> g;
+    std::vector<FieldT> p;
+    g.reserve(updates.size());
+    p.reserve(updates.size());
+
+    for (const update &u : updates)
+    {
+        ASSERT(u.index < this->bases_.size());
+        const FieldT delta = u.new_value - u.old_value;
+        if (!delta.is_zero())
+        {
+            g.emplace_back(this->bases_[u.index]);
+            p.emplace_back(delta);
+        }
+    }
+
+    if (g.empty())
+    {
+        return;
+    }
+
+    if (g.size() < straus_threshold)
+    {
+        this->value_ = this->value_ + multi_exp<T, FieldT, multi_exp_method_straus>(
+            g.cbegin(), g.cend(), p.cbegin(), p.cend(), 1);
+    }
+    else
+    {
+        this->value_ = this->value_ + multi_exp<T, FieldT, multi_exp_method_BDLO12>(
+            g.cbegin(), g.cend(), p.cbegin(), p.cend(), chunks);
+    }
+}
+
+template<typename T, typename FieldT>
+void multi_exp_incremental<T, FieldT>::apply(const size_t index, const FieldT &old_value, const FieldT &new_value)
+{
+    ASSERT(index < this->bases_.size());
+    this->value_ = this->value_ + (new_value - old_value) * this->bases_[index];
+}
+
+} // libff
+
+#endif // MULTIEXP_INCREMENTAL_TCC_
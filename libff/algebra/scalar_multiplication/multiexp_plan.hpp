@@ -0,0 +1,99 @@
+/** @file
+ *****************************************************************************
+
+ Declaration of a memory-budgeted planner for multi-exponentiation.
+
+ multi_exp picks its window size from the number of scalars alone, and
+ converts all scalars to bigints up front; on large inputs in G2 its 2^c
+ buckets per thread and the scalar copy can exceed the memory of a process,
+ and LOWMEM only caps fixed-base windows at compile time. The planner
+ instead chooses the method, window size, number of tiles (ranges of the
+ input handled by one thread at a time), number of threads and scalar-copy
+ strategy that minimize an estimate of the running time, among those whose
+ estimated peak memory fits a given budget.
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef MULTIEXP_PLAN_HPP_
+#define MULTIEXP_PLAN_HPP_
+
+#include <cstddef>
+#include <vector>
+
+#include <libff/algebra/scalar_multiplication/multiexp.hpp>
+
+namespace libff {
+
+enum multi_exp_scalar_copy {
+    /* scalars are already bigints and are used in place */
+    multi_exp_scalar_copy_none,
+    /* all scalars are converted to bigints before any tile starts, as in multi_exp */
+    multi_exp_scalar_copy_full,
+    /* each tile converts its own scalars, so only the running tiles hold copies */
+    multi_exp_scalar_copy_per_tile
+};
+
+struct multi_exp_plan {
+    size_t num_scalars;
+    /* multi_exp_method_BDLO12 or multi_exp_method_straus */
+    multi_exp_method method;
+    /* c of multi_exp_method_BDLO12; the wNAF window of multi_exp_method_straus */
+    size_t window_size;
+    size_t num_tiles;
+    size_t num_threads;
+    multi_exp_scalar_copy scalar_copy;
+    /**
+     * estimated peak memory, in bytes, besides the bases and scalars
+     * themselves; includes the scratch arena (see scratch_arena.hpp) of each
+     * running thread at the capacity it grows to from empty, in whole chunks
+     * of at least min_chunk_size
+     */
+    size_t estimated_memory;
+    /* estimated running time, in group additions per thread */
+    double estimated_cost;
+    /**
+     * false if no plan fits the budget, in which case this is the fastest of
+     * those that exceed it by the fewest min_chunk_size chunks
+     */
+    bool fits_budget;
+};
+
+/**
+ * Plans a multi-exponentiation of num_scalars terms in T with scalars of
+ * type FieldT (a field or bigint<n>, as for multi_exp), on at most
+ * num_threads threads (0 for all available) and within memory_budget bytes
+ * of working memory.
+ */
+template<typename T, typename FieldT>
+multi_exp_plan plan_multi_exp(const size_t num_scalars,
+                              const size_t memory_budget,
+                              const size_t num_threads = 0);
+
+/* Prints the plan, unless inhibit_profiling_info is set. */
+inline void print_multi_exp_plan(const multi_exp_plan &plan);
+
+/**
+ * Computes \sum_i scalar_start[i] * vec_start[i] as planned. The plan must
+ * have been made for the same T, FieldT and number of scalars. Tiles draw
+ * their buckets from the scratch arenas of their threads; before the call
+ * returns, each of those threads trims its arena back to the capacity it
+ * had on entry (see scratch_arena::trim), so chunks the call added are not
+ * retained, while capacity kept on purpose (e.g., by scratch_arena::reset)
+ * stays.
+ */
+template<typename T, typename FieldT>
+T multi_exp_planned(typename std::vector<T>::const_iterator vec_start,
+                    typename std::vector<T>::const_iterator vec_end,
+                    typename std::vector<FieldT>::const_iterator scalar_start,
+                    typename std::vector<FieldT>::const_iterator scalar_end,
+                    const multi_exp_plan &plan);
+
+} // libff
+
+#include <libff/algebra/scalar_multiplication/multiexp_plan.tcc>
+
+#endif // MULTIEXP_PLAN_HPP_
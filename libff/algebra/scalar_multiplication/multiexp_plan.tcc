@@ -0,0 +1,380 @@
+/** @file
+ *****************************************************************************
+
+ Implementation of a memory-budgeted planner for multi-exponentiation.
+
+ See multiexp_plan.hpp .
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef MULTIEXP_PLAN_TCC_
+#define MULTIEXP_PLAN_TCC_
+
+#include <algorithm>
+#include <cstdio>
+#include <type_traits>
+
+#ifdef MULTICORE
+#include <omp.h>
+#endif
+
+#include <libff/common/assert.hpp>
+#include <libff/common/huge_pages.hpp>
+#include <libff/common/profiling.hpp>
+#include <libff/common/scratch_arena.hpp>
+
+namespace libff {
+
+/* the largest window size the planner considers for multi_exp_method_BDLO12 */
+const size_t multi_exp_plan_max_window_size = 24;
+
+template<typename FieldT>
+struct multi_exp_scalar_traits {
+    static const bool canonical = false;
+    static size_t num_bits() { return FieldT::size_in_bits(); }
+};
+
+template<mp_size_t n>
+struct multi_exp_scalar_traits<bigint<n> > {
+    static const bool canonical = true;
+    static size_t num_bits() { return n * GMP_NUMB_BITS; }
+};
+
+/* count allocations of bytes each, with the given alignment */
+struct multi_exp_plan_allocation {
+    size_t bytes;
+    size_t alignment;
+    size_t count;
+};
+
+/**
+ * The capacity that a fresh scratch arena grows to when serving the given
+ * allocations in order, following scratch_arena::allocate: chunks of at
+ * least min_chunk_size, each at least twice the previous one, rounded up to
+ * huge pages when those are mapped.
+ */
+inline size_t multi_exp_plan_arena_capacity(const std::vector<multi_exp_plan_allocation> &allocations)
+{
+    std::vector<size_t> sizes, used;
+    size_t current = 0;
+    for (const multi_exp_plan_allocation &a : allocations)
+    {
+        size_t remaining = a.count;
+        while (remaining > 0)
+        {
+            if (current < sizes.size())
+            {
+                const size_t padding = (a.alignment - used[current] % a.alignment) % a.alignment;
+                const size_t free_bytes = (used[current] + padding <= sizes[current] ?
+                                           sizes[current] - used[current] - padding : 0);
+                const size_t fit = std::min(remaining, a.bytes == 0 ? remaining : free_bytes / a.bytes);
+                if (fit > 0)
+                {
+                    used[current] += padding + fit * a.bytes;
+                    remaining -= fit;
+                    continue;
+                }
+                if (current + 1 < sizes.size())
+                {
+                    ++current;
+                    continue;
+                }
+            }
+
+            size_t size = std::max(std::max(scratch_arena::min_chunk_size,
+                                            (sizes.empty() ? 0 : 2 * sizes.back())),
+                                   a.bytes + a.alignment);
+            if (huge_pages != huge_pages_off && size >= huge_page_size)
+            {
+                size = (size + huge_page_size - 1) / huge_page_size * huge_page_size;
+            }
+            sizes.emplace_back(size);
+            used.emplace_back(0);
+            current = sizes.size() - 1;
+        }
+    }
+
+    size_t capacity = 0;
+    for (const size_t size : sizes)
+    {
+        capacity += size;
+    }
+    return capacity;
+}
+
+template<typename T, typename FieldT>
+void multi_exp_plan_estimate(multi_exp_plan &plan)
+{
+    typedef typename multi_exp_canonical_scalars<FieldT>::bigint_type BigIntT;
+    typedef typename multi_exp_accumulator<T>::type A;
+
+    const size_t bits = multi_exp_scalar_traits<FieldT>::num_bits();
+    const size_t tile_length = (plan.num_scalars + plan.num_tiles - 1) / plan.num_tiles;
+    const size_t c = plan.window_size;
+
+    /*
+      working memory of one running tile: what it draws from the scratch
+      arena of its thread, in the order it does so, and what it takes from
+      the heap
+    */
+    std::vector<multi_exp_plan_allocation> arena_allocations;
+    size_t tile_heap = 0;
+    double tile_cost = 0;
+    if (plan.method == multi_exp_method_straus)
+    {
+        const size_t naf_length = 8 * sizeof(BigIntT) + 1;
+        arena_allocations.push_back({ tile_length * (1ul << (c-1)) * sizeof(T), alignof(T), 1 });
+        arena_allocations.push_back({ naf_length * sizeof(long), alignof(long), tile_length });
+        tile_heap = tile_length * sizeof(std::vector<long>);
+        tile_cost = tile_length * ((1ul << (c-1)) + double(bits) / (c+1)) + bits;
+    }
+    else
+    {
+        const size_t num_windows = (bits + c - 1) / c;
+#ifdef USE_MIXED_ADDITION
+        tile_heap = (1ul << c) * sizeof(A);
+#else
+        if (!std::is_same<A, T>::value)
+        {
+            arena_allocations.push_back({ tile_length * sizeof(A), alignof(A), 1 });
+        }
+        arena_allocations.push_back({ (1ul << c) * sizeof(A), alignof(A), 1 });
+#endif
+        arena_allocations.push_back({ ((1ul << c) + 63) / 64 * 8, alignof(uint64_t), 1 });
+        tile_cost = num_windows * (double(tile_length) + double(1ul << (c+1)) + c);
+    }
+    if (plan.scalar_copy == multi_exp_scalar_copy_per_tile)
+    {
+        tile_heap += tile_length * sizeof(BigIntT);
+    }
+
+    const size_t running = std::min(plan.num_tiles, plan.num_threads);
+    plan.estimated_memory = running * (multi_exp_plan_arena_capacity(arena_allocations) + tile_heap) +
+        plan.num_tiles * sizeof(T);
+    if (plan.scalar_copy == multi_exp_scalar_copy_full)
+    {
+        plan.estimated_memory += plan.num_scalars * sizeof(BigIntT);
+    }
+    plan.estimated_cost = ((plan.num_tiles + running - 1) / running) * tile_cost + plan.num_tiles;
+}
+
+template<typename T, typename FieldT>
+multi_exp_plan plan_multi_exp(const size_t num_scalars,
+                              const size_t memory_budget,
+                              const size_t num_threads)
+{
+#ifdef MULTICORE
+    const size_t max_threads = (num_threads == 0 ? static_cast<size_t>(omp_get_max_threads()) : num_threads);
+#else
+    const size_t max_threads = 1;
+    UNUSED(num_threads);
+#endif
+
+    multi_exp_plan best;
+    best.num_scalars = num_scalars;
+    best.method = multi_exp_method_BDLO12;
+    best.window_size = 1;
+    best.num_tiles = 1;
+    best.num_threads = 1;
+    best.scalar_copy = (multi_exp_scalar_traits<FieldT>::canonical ?
+                        multi_exp_scalar_copy_none : multi_exp_scalar_copy_full);
+    best.fits_budget = false;
+    if (num_scalars == 0)
+    {
+        best.estimated_memory = 0;
+        best.estimated_cost = 0;
+        best.fits_budget = true;
+        return best;
+    }
+    multi_exp_plan_estimate<T, FieldT>(best);
+
+    std::vector<multi_exp_scalar_copy> copies;
+    if (multi_exp_scalar_traits<FieldT>::canonical)
+    {
+        copies.emplace_back(multi_exp_scalar_copy_none);
+    }
+    else
+    {
+        copies.emplace_back(multi_exp_scalar_copy_full);
+        copies.emplace_back(multi_exp_scalar_copy_per_tile);
+    }
+
+    const size_t log_n = log2(num_scalars);
+    const size_t max_c = std::min(multi_exp_plan_max_window_size, log_n + 1);
+
+    multi_exp_plan candidate = best;
+    for (size_t t = 1; t <= std::min(max_threads, num_scalars); ++t)
+    {
+        for (size_t tiles = t; tiles <= num_scalars; tiles *= 2)
+        {
+            for (const multi_exp_scalar_copy copy : copies)
+            {
+                for (size_t c = 0; c <= max_c; ++c)
+                {
+                    /* c = 0 stands for multi_exp_method_straus */
+                    candidate.method = (c == 0 ? multi_exp_method_straus : multi_exp_method_BDLO12);
+                    candidate.window_size = (c == 0 ? multi_exp_straus_window_size : c);
+                    candidate.num_tiles = tiles;
+                    candidate.num_threads = t;
+                    candidate.scalar_copy = copy;
+                    multi_exp_plan_estimate<T, FieldT>(candidate);
+                    candidate.fits_budget = (candidate.estimated_memory <= memory_budget);
+
+                    bool better;
+                    if (candidate.fits_budget != best.fits_budget)
+                    {
+                        better = candidate.fits_budget;
+                    }
+                    else if (candidate.fits_budget)
+                    {
+                        better = (candidate.estimated_cost < best.estimated_cost ||
+                                  (candidate.estimated_cost == best.estimated_cost &&
+                                   candidate.estimated_memory < best.estimated_memory));
+                    }
+                    else
+                    {
+                        /* memory is committed in arena chunks, so smaller differences do not matter */
+                        const size_t candidate_chunks = (candidate.estimated_memory + scratch_arena::min_chunk_size - 1) / scratch_arena::min_chunk_size;
+                        const size_t best_chunks = (best.estimated_memory + scratch_arena::min_chunk_size - 1) / scratch_arena::min_chunk_size;
+                        better = (candidate_chunks < best_chunks ||
+                                  (candidate_chunks == best_chunks &&
+                                   candidate.estimated_cost < best.estimated_cost));
+                    }
+
+                    if (better)
+                    {
+                        best = candidate;
+                    }
+                }
+            }
+        }
+    }
+
+    return best;
+}
+
+void print_multi_exp_plan(const multi_exp_plan &plan)
+{
+    if (inhibit_profiling_info)
+    {
+        return;
+    }
+
+    const char *copy_names[] = { "none", "full", "per tile" };
+    print_indent(); printf("* Multi-exponentiation plan for %zu scalars: %s, window size %zu, %zu tiles on %zu threads, scalar copy: %s\n",
+                           plan.num_scalars,
+                           (plan.method == multi_exp_method_straus ? "Straus" : "BDLO12"),
+                           plan.window_size, plan.num_tiles, plan.num_threads,
+                           copy_names[plan.scalar_copy]);
+    print_indent(); printf("* Estimated memory: %0.2f MiB%s, estimated cost: %0.0f additions\n",
+                           plan.estimated_memory / 1048576.,
+                           (plan.fits_budget ? "" : " (over budget)"),
+                           plan.estimated_cost);
+}
+
+template<typename T, typename BigIntT>
+T multi_exp_planned_tile(typename std::vector<T>::const_iterator vec_start,
+                         typename std::vector<T>::const_iterator vec_end,
+                         typename std::vector<BigIntT>::const_iterator scalar_start,
+                         const multi_exp_plan &plan)
+{
+    const size_t length = vec_end - vec_start;
+    if (plan.method == multi_exp_method_straus)
+    {
+        return multi_exp_inner<T, BigIntT, multi_exp_method_straus>(
+            vec_start, vec_end, scalar_start, scalar_start + length);
+    }
+
+    const size_t c = plan.window_size;
+    size_t num_bits = 0;
+    for (size_t i = 0; i < length; ++i)
+    {
+        num_bits = std::max(num_bits, scalar_start[i].num_bits());
+    }
+    if (num_bits == 0)
+    {
+        return T::zero();
+    }
+
+    return multi_exp_BDLO12_buckets<T>(vec_start, vec_end, c, (num_bits + c - 1) / c,
+                                       [&](const size_t k, const size_t i) {
+                                           return multi_exp_window_digit(scalar_start[i], k * c, c);
+                                       });
+}
+
+template<typename T, typename FieldT>
+T multi_exp_planned(typename std::vector<T>::const_iterator vec_start,
+                    typename std::vector<T>::const_iterator vec_end,
+                    typename std::vector<FieldT>::const_iterator scalar_start,
+                    typename std::vector<FieldT>::const_iterator scalar_end,
+                    const multi_exp_plan &plan)
+{
+    typedef typename multi_exp_canonical_scalars<FieldT>::bigint_type BigIntT;
+
+    const size_t total = vec_end - vec_start;
+    ASSERT(scalar_end - scalar_start == vec_end - vec_start);
+    ASSERT(total == plan.num_scalars);
+    if (total == 0)
+    {
+        return T::zero();
+    }
+
+    enter_block("Call to multi_exp_planned");
+    print_multi_exp_plan(plan);
+
+    /* with a per-tile copy, nothing is converted up front */
+    const bool per_tile = (plan.scalar_copy == multi_exp_scalar_copy_per_tile);
+    const multi_exp_canonical_scalars<FieldT> all_scalars(scalar_start, (per_tile ? scalar_start : scalar_end));
+
+    const size_t num_tiles = std::min(plan.num_tiles, total);
+    const size_t one = total/num_tiles;
+    std::vector<T> partial(num_tiles, T::zero());
+
+#ifdef MULTICORE
+#pragma omp parallel num_threads(plan.num_threads)
+#endif
+    {
+        /* each thread gives back the chunks its tiles added, keeping what its arena held before */
+        scratch_arena &arena = scratch_arena::thread_arena();
+        const size_t initial_capacity = arena.capacity();
+
+#ifdef MULTICORE
+#pragma omp for
+#endif
+        for (size_t i = 0; i < num_tiles; ++i)
+        {
+            const size_t begin = i*one;
+            const size_t end = (i == num_tiles-1 ? total : (i+1)*one);
+            if (per_tile)
+            {
+                const multi_exp_canonical_scalars<FieldT> tile_scalars(scalar_start + begin, scalar_start + end);
+                partial[i] = multi_exp_planned_tile<T, BigIntT>(vec_start + begin, vec_start + end,
+                                                                tile_scalars.begin(), plan);
+            }
+            else
+            {
+                partial[i] = multi_exp_planned_tile<T, BigIntT>(vec_start + begin, vec_start + end,
+                                                                all_scalars.begin() + begin, plan);
+            }
+        }
+
+        arena.trim(initial_capacity);
+    }
+
+    T result = T::zero();
+    for (size_t i = 0; i < num_tiles; ++i)
+    {
+        result = result + partial[i];
+    }
+
+    leave_block("Call to multi_exp_planned");
+    return result;
+}
+
+} // libff
+
+#endif // MULTIEXP_PLAN_TCC_
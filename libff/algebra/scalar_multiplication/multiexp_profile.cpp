@@ -107,6 +107,15 @@ void print_performance_csv(
             if (compare_answers && (result_bos_coster.second != result_naive.second)) {
                 fprintf(stderr, "Answers NOT MATCHING (bos coster != naive)\n");
             }
+
+            run_result_t<GroupT> result_straus =
+                profile_multiexp<GroupT, FieldT, multi_exp_method_straus>(
+                    group_elements, scalars);
+            printf("\t%lld", result_straus.first); fflush(stdout);
+
+            if (compare_answers && (result_bos_coster.second != result_straus.second)) {
+                fprintf(stderr, "Answers NOT MATCHING (bos coster != straus)\n");
+            }
         }
 
         printf("\n");
@@ -0,0 +1,89 @@
+/** @file
+ *****************************************************************************
+
+ Declaration of sharded multi-exponentiation, for splitting one large
+ multi-exponentiation across several processes or machines.
+
+ Each shard runs the bucket method of multi_exp_method_BDLO12 over a range
+ of the bases and scalars, but stops before combining its windows: what it
+ returns is the sum of every c-bit window, one group element per window.
+ These are small (about 256 / c elements, whatever the size of the range)
+ and serialize with the usual stream operators, so each worker can read its
+ own range of a shared key file, write its shard, and leave the combination
+ to a single process, which adds the shards window by window and does the
+ c doublings per window once, rather than once per shard.
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef MULTIEXP_SHARD_HPP_
+#define MULTIEXP_SHARD_HPP_
+
+#include <iostream>
+#include <vector>
+
+#include <libff/algebra/scalar_multiplication/multiexp.hpp>
+
+namespace libff {
+
+template<typename T>
+class multi_exp_shard;
+
+template<typename T>
+std::ostream& operator<<(std::ostream &out, const multi_exp_shard<T> &shard);
+
+template<typename T>
+std::istream& operator>>(std::istream &in, multi_exp_shard<T> &shard);
+
+/**
+ * The partial result of a multi-exponentiation over part of its input:
+ * window_sums[k] = \sum_i (bits [k*c, (k+1)*c) of scalar i) * base i,
+ * summed over the bases of the shard, where c = window_size.
+ */
+template<typename T>
+class multi_exp_shard {
+public:
+    size_t window_size;
+    std::vector<T> window_sums;
+
+    multi_exp_shard() : window_size(0) {};
+    multi_exp_shard(const size_t window_size, const std::vector<T> &window_sums) :
+        window_size(window_size), window_sums(window_sums) {};
+
+    bool operator==(const multi_exp_shard<T> &other) const;
+    bool operator!=(const multi_exp_shard<T> &other) const;
+
+    friend std::ostream& operator<< <T>(std::ostream &out, const multi_exp_shard<T> &shard);
+    friend std::istream& operator>> <T>(std::istream &in, multi_exp_shard<T> &shard);
+};
+
+/**
+ * The shard of \sum_i scalar_start[i] * vec_start[i] over the given range.
+ * All shards of one multi-exponentiation must use the same window size;
+ * get_multi_exp_window_size of the size of a typical shard is a good
+ * choice. The range is split into chunks as for multi_exp, processed in
+ * parallel under MULTICORE. FieldT is a field or bigint<n>, as for multi_exp.
+ */
+template<typename T, typename FieldT>
+multi_exp_shard<T> multi_exp_shard_compute(typename std::vector<T>::const_iterator vec_start,
+                                           typename std::vector<T>::const_iterator vec_end,
+                                           typename std::vector<FieldT>::const_iterator scalar_start,
+                                           typename std::vector<FieldT>::const_iterator scalar_end,
+                                           const size_t window_size,
+                                           const size_t chunks);
+
+/**
+ * Adds the shards (e.g., read back from their workers) into the result of
+ * the whole multi-exponentiation. The order of the shards does not matter.
+ */
+template<typename T>
+T multi_exp_combine_shards(const std::vector<multi_exp_shard<T> > &shards);
+
+} // libff
+
+#include <libff/algebra/scalar_multiplication/multiexp_shard.tcc>
+
+#endif // MULTIEXP_SHARD_HPP_
@@ -0,0 +1,169 @@
+/** @file
+ *****************************************************************************
+
+ Implementation of sharded multi-exponentiation.
+
+ See multiexp_shard.hpp .
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef MULTIEXP_SHARD_TCC_
+#define MULTIEXP_SHARD_TCC_
+
+#include <algorithm>
+
+#include <libff/common/assert.hpp>
+#include <libff/common/serialization.hpp>
+
+namespace libff {
+
+template<typename T>
+bool multi_exp_shard<T>::operator==(const multi_exp_shard<T> &other) const
+{
+    return (this->window_size == other.window_size &&
+            this->window_sums == other.window_sums);
+}
+
+template<typename T>
+bool multi_exp_shard<T>::operator!=(const multi_exp_shard<T> &other) const
+{
+    return !(operator==(other));
+}
+
+template<typename T>
+std::ostream& operator<<(std::ostream &out, const multi_exp_shard<T> &shard)
+{
+    out << shard.window_size << "\n";
+    out << shard.window_sums.size() << "\n";
+    for (const T &w : shard.window_sums)
+    {
+        out << w << OUTPUT_NEWLINE;
+    }
+
+    return out;
+}
+
+template<typename T>
+std::istream& operator>>(std::istream &in, multi_exp_shard<T> &shard)
+{
+    in >> shard.window_size;
+    consume_newline(in);
+
+    size_t num_windows;
+    in >> num_windows;
+    consume_newline(in);
+
+    shard.window_sums.resize(num_windows);
+    for (size_t k = 0; k < num_windows; ++k)
+    {
+        in >> shard.window_sums[k];
+        consume_OUTPUT_NEWLINE(in);
+    }
+
+    return in;
+}
+
+template<typename T, typename FieldT>
+multi_exp_shard<T> multi_exp_shard_compute(typename std::vector<T>::const_iterator vec_start,
+                                           typename std::vector<T>::const_iterator vec_end,
+                                           typename std::vector<FieldT>::const_iterator scalar_start,
+                                           typename std::vector<FieldT>::const_iterator scalar_end,
+                                           const size_t window_size,
+                                           const size_t chunks)
+{
+    ASSERT(vec_end - vec_start == scalar_end - scalar_start);
+    ASSERT(window_size > 0 && window_size <= 32);
+
+    typedef typename multi_exp_canonical_scalars<FieldT>::bigint_type BigIntT;
+    const multi_exp_canonical_scalars<FieldT> scalars(scalar_start, scalar_end);
+    const typename std::vector<BigIntT>::const_iterator bn = scalars.begin();
+
+    const size_t total = vec_end - vec_start;
+    size_t num_bits = 0;
+    for (size_t i = 0; i < total; ++i)
+    {
+        num_bits = std::max(num_bits, bn[i].num_bits());
+    }
+    const size_t num_windows = (num_bits + window_size - 1) / window_size;
+
+    multi_exp_shard<T> shard(window_size, std::vector<T>(num_windows, T::zero()));
+    if (num_windows == 0)
+    {
+        return shard;
+    }
+
+    const size_t num_chunks = ((total < chunks || chunks == 0) ? 1 : chunks);
+    const size_t one = total/num_chunks;
+    std::vector<std::vector<T> > partial(num_chunks);
+
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+    for (size_t i = 0; i < num_chunks; ++i)
+    {
+        const size_t offset = i*one;
+        multi_exp_BDLO12_buckets<T>(
+            vec_start + offset,
+            (i == num_chunks-1 ? vec_end : vec_start + (i+1)*one),
+            window_size, num_windows,
+            [&](const size_t k, const size_t j) {
+                return multi_exp_window_digit(bn[offset + j], k * window_size, window_size);
+            },
+            &partial[i]);
+    }
+
+    for (size_t i = 0; i < num_chunks; ++i)
+    {
+        for (size_t k = 0; k < num_windows; ++k)
+        {
+            shard.window_sums[k] = shard.window_sums[k] + partial[i][k];
+        }
+    }
+
+    return shard;
+}
+
+template<typename T>
+T multi_exp_combine_shards(const std::vector<multi_exp_shard<T> > &shards)
+{
+    if (shards.empty())
+    {
+        return T::zero();
+    }
+
+    /* shards whose scalars happen to be shorter have fewer windows */
+    const size_t c = shards[0].window_size;
+    size_t num_windows = 0;
+    for (const multi_exp_shard<T> &shard : shards)
+    {
+        ASSERT(shard.window_size == c);
+        num_windows = std::max(num_windows, shard.window_sums.size());
+    }
+
+    T result = T::zero();
+    for (size_t k = num_windows - 1; k < num_windows; --k)
+    {
+        for (size_t i = 0; i < c && !result.is_zero(); ++i)
+        {
+            result = result.dbl();
+        }
+
+        for (const multi_exp_shard<T> &shard : shards)
+        {
+            if (k < shard.window_sums.size())
+            {
+                result = result + shard.window_sums[k];
+            }
+        }
+    }
+
+    return result;
+}
+
+} // libff
+
+#endif // MULTIEXP_SHARD_TCC_
@@ -0,0 +1,68 @@
+#include <cstdio>
+#include <vector>
+
+#include <libff/algebra/curves/alt_bn128/alt_bn128_pp.hpp>
+#include <libff/algebra/curves/curve_utils.hpp>
+#include <libff/common/profiling.hpp>
+#include <libff/common/rng.hpp>
+
+using namespace libff;
+
+template<typename GroupT, typename FieldT>
+void profile_scalar_mul(const size_t count)
+{
+    std::vector<GroupT> bases;
+    std::vector<bigint<FieldT::num_limbs> > scalars;
+    for (size_t i = 0; i < count; i++) {
+        bases.push_back(GroupT::random_element());
+        scalars.push_back(SHA512_rng<FieldT>(i).as_bigint());
+    }
+
+    std::vector<GroupT> variable_time, constant_time, ladder;
+
+    long long start_time = get_nsec_time();
+    for (size_t i = 0; i < count; i++) {
+        variable_time.push_back(scalar_mul<GroupT>(bases[i], scalars[i]));
+    }
+    const long long variable_time_ns = get_nsec_time() - start_time;
+
+    start_time = get_nsec_time();
+    for (size_t i = 0; i < count; i++) {
+        constant_time.push_back(constant_time_scalar_mul<GroupT>(bases[i], scalars[i]));
+    }
+    const long long constant_time_ns = get_nsec_time() - start_time;
+
+    start_time = get_nsec_time();
+    const std::vector<GroupT> batch = batch_constant_time_scalar_mul<GroupT>(bases, scalars);
+    const long long batch_ns = get_nsec_time() - start_time;
+
+    start_time = get_nsec_time();
+    for (size_t i = 0; i < count; i++) {
+        ladder.push_back(montgomery_ladder_scalar_mul<GroupT>(bases[i], scalars[i]));
+    }
+    const long long ladder_ns = get_nsec_time() - start_time;
+
+    if (variable_time != constant_time || variable_time != batch || variable_time != ladder) {
+        fprintf(stderr, "Answers NOT MATCHING\n");
+    }
+
+    printf("variable-time wNAF:        %lld ns per scalar multiplication\n", variable_time_ns / (long long)count);
+    printf("constant-time window:      %lld ns per scalar multiplication\n", constant_time_ns / (long long)count);
+    printf("constant-time batch:       %lld ns per scalar multiplication\n", batch_ns / (long long)count);
+    printf("Montgomery ladder:         %lld ns per scalar multiplication\n", ladder_ns / (long long)count);
+}
+
+int main(void)
+{
+    print_compilation_info();
+
+    alt_bn128_pp::init_public_params();
+
+    printf("Profiling alt_bn128_G1\n");
+    profile_scalar_mul<G1<alt_bn128_pp>, Fr<alt_bn128_pp> >(1000);
+
+    printf("Profiling alt_bn128_G2\n");
+    profile_scalar_mul<G2<alt_bn128_pp>, Fr<alt_bn128_pp> >(200);
+
+    return 0;
+}
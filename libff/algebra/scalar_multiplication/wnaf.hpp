@@ -24,6 +24,12 @@ namespace libff {
 template<mp_size_t n>
 std::vector<long> find_wnaf(const size_t window_size, const bigint<n> &scalar);
 
+/**
+ * As above, into res, which is resized to scalar.max_bits() + 1 digits.
+ */
+template<mp_size_t n, typename Allocator>
+void find_wnaf(std::vector<long, Allocator> &res, const size_t window_size, const bigint<n> &scalar);
+
 /**
  * In additive notation, use wNAF exponentiation (with the given window size) to compute scalar * base.
  */
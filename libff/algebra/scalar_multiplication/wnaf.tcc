@@ -16,13 +16,23 @@
 
 #include <gmp.h>
 
+#include <libff/common/scratch_arena.hpp>
+
 namespace libff {
 
 template<mp_size_t n>
 std::vector<long> find_wnaf(const size_t window_size, const bigint<n> &scalar)
+{
+    std::vector<long> res;
+    find_wnaf(res, window_size, scalar);
+    return res;
+}
+
+template<mp_size_t n, typename Allocator>
+void find_wnaf(std::vector<long, Allocator> &res, const size_t window_size, const bigint<n> &scalar)
 {
     const size_t length = scalar.max_bits(); // upper bound
-    std::vector<long> res(length+1);
+    res.assign(length+1, 0);
     bigint<n> c = scalar;
     size_t j = 0;
     while (!c.is_zero())
@@ -54,15 +64,15 @@ std::vector<long> find_wnaf(const size_t window_size, const bigint<n> &scalar)
 
         mpn_rshift(c.data, c.data, n, 1); // c = c/2
     }
-
-    return res;
 }
 
 template<typename T, mp_size_t n>
 T fixed_window_wnaf_exp(const size_t window_size, const T &base, const bigint<n> &scalar)
 {
-    std::vector<long> naf = find_wnaf(window_size, scalar);
-    std::vector<T> table(1ul<<(window_size-1));
+    const scratch_scope scope;
+    scratch_vector<long> naf;
+    find_wnaf(naf, window_size, scalar);
+    scratch_vector<T> table(1ul<<(window_size-1));
     T tmp = base;
     T dbl = base.dbl();
     for (size_t i = 0; i < 1ul<<(window_size-1); ++i)
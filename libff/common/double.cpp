@@ -41,10 +41,12 @@ namespace libff {
     val = num;
   }
 
+#ifdef PROFILE_OP_COUNTS
   unsigned Double::add_cnt = 0;
   unsigned Double::sub_cnt = 0;
   unsigned Double::mul_cnt = 0;
   unsigned Double::inv_cnt = 0;
+#endif
 
   Double Double::operator+(const Double &other) const
   {
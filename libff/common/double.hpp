@@ -31,10 +31,12 @@ namespace libff {
 
       Double(std::complex<double> num);
 
+#ifdef PROFILE_OP_COUNTS
       static unsigned add_cnt;
       static unsigned sub_cnt;
       static unsigned mul_cnt;
       static unsigned inv_cnt;
+#endif
 
       Double operator+(const Double &other) const;
       Double operator-(const Double &other) const;
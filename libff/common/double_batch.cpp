@@ -0,0 +1,380 @@
+/** @file
+ *****************************************************************************
+
+ Implementation of batches of complex numbers and their FFT.
+
+ See double_batch.hpp .
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__x86_64__) && defined(USE_ASM)
+#include <immintrin.h>
+#endif
+
+#include <libff/common/assert.hpp>
+#include <libff/common/double_batch.hpp>
+#include <libff/common/utils.hpp>
+
+namespace libff {
+
+bool double_batch_backend_supported(const double_batch_backend backend)
+{
+    switch (backend)
+    {
+    case double_batch_backend_scalar:
+        return true;
+#if defined(__x86_64__) && defined(USE_ASM)
+    case double_batch_backend_avx2:
+        return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#endif
+    default:
+        return false;
+    }
+}
+
+double_batch_backend double_batch_default_backend()
+{
+    static const double_batch_backend backend =
+        double_batch_backend_supported(double_batch_backend_avx2) ? double_batch_backend_avx2 :
+        double_batch_backend_scalar;
+    return backend;
+}
+
+Double_fft_twiddles::Double_fft_twiddles(const size_t n) : n(n), re(n > 1 ? n - 1 : 0), im(n > 1 ? n - 1 : 0)
+{
+    ASSERT(n == 0 || (n & (n - 1)) == 0);
+
+    if (n < 2)
+    {
+        return;
+    }
+
+    /* the last stage, omega_n^j = exp(2 pi i j / n) for j < n/2, using exp(pi i - x) = -conj(exp(x)) */
+    const double PI = 3.141592653589793238460264338328L;
+    const size_t top = n / 2;
+    double *top_re = &this->re[top - 1], *top_im = &this->im[top - 1];
+    for (size_t j = 0; j <= top / 2; ++j)
+    {
+        top_re[j] = cos(2 * PI * j / n);
+        top_im[j] = sin(2 * PI * j / n);
+    }
+    for (size_t j = top / 2 + 1; j < top; ++j)
+    {
+        top_re[j] = -top_re[top - j];
+        top_im[j] = top_im[top - j];
+    }
+
+    /* omega_{2m}^j = omega_n^(j * n/2m), so the earlier stages subsample the last one */
+    for (size_t m = 1; m < top; m *= 2)
+    {
+        const size_t stride = top / m;
+        for (size_t j = 0; j < m; ++j)
+        {
+            this->re[m - 1 + j] = top_re[j * stride];
+            this->im[m - 1 + j] = top_im[j * stride];
+        }
+    }
+}
+
+/* (lo, hi) = (lo + w * hi, lo - w * hi), element-wise over count elements */
+static void double_batch_butterflies_scalar(double *lo_re, double *lo_im, double *hi_re, double *hi_im,
+                                            const double *w_re, const double *w_im, const size_t count)
+{
+    for (size_t j = 0; j < count; ++j)
+    {
+        const double t_re = w_re[j] * hi_re[j] - w_im[j] * hi_im[j];
+        const double t_im = w_re[j] * hi_im[j] + w_im[j] * hi_re[j];
+        hi_re[j] = lo_re[j] - t_re;
+        hi_im[j] = lo_im[j] - t_im;
+        lo_re[j] += t_re;
+        lo_im[j] += t_im;
+    }
+}
+
+/* out = a (op) b, element-wise; op is 0 for +, 1 for -, 2 for * */
+static void double_batch_arith_scalar(const int op, const double *a_re, const double *a_im,
+                                      const double *b_re, const double *b_im,
+                                      double *out_re, double *out_im, const size_t count)
+{
+    for (size_t j = 0; j < count; ++j)
+    {
+        if (op == 0)
+        {
+            out_re[j] = a_re[j] + b_re[j];
+            out_im[j] = a_im[j] + b_im[j];
+        }
+        else if (op == 1)
+        {
+            out_re[j] = a_re[j] - b_re[j];
+            out_im[j] = a_im[j] - b_im[j];
+        }
+        else
+        {
+            const double re = a_re[j] * b_re[j] - a_im[j] * b_im[j];
+            const double im = a_re[j] * b_im[j] + a_im[j] * b_re[j];
+            out_re[j] = re;
+            out_im[j] = im;
+        }
+    }
+}
+
+#if defined(__x86_64__) && defined(USE_ASM)
+__attribute__((target("avx2,fma")))
+static void double_batch_butterflies_avx2(double *lo_re, double *lo_im, double *hi_re, double *hi_im,
+                                          const double *w_re, const double *w_im, const size_t count)
+{
+    size_t j = 0;
+    for (; j + 4 <= count; j += 4)
+    {
+        const __m256d wr = _mm256_loadu_pd(w_re + j);
+        const __m256d wi = _mm256_loadu_pd(w_im + j);
+        const __m256d hr = _mm256_loadu_pd(hi_re + j);
+        const __m256d hi = _mm256_loadu_pd(hi_im + j);
+        const __m256d lr = _mm256_loadu_pd(lo_re + j);
+        const __m256d li = _mm256_loadu_pd(lo_im + j);
+
+        const __m256d tr = _mm256_fmsub_pd(wr, hr, _mm256_mul_pd(wi, hi));
+        const __m256d ti = _mm256_fmadd_pd(wr, hi, _mm256_mul_pd(wi, hr));
+
+        _mm256_storeu_pd(hi_re + j, _mm256_sub_pd(lr, tr));
+        _mm256_storeu_pd(hi_im + j, _mm256_sub_pd(li, ti));
+        _mm256_storeu_pd(lo_re + j, _mm256_add_pd(lr, tr));
+        _mm256_storeu_pd(lo_im + j, _mm256_add_pd(li, ti));
+    }
+    double_batch_butterflies_scalar(lo_re + j, lo_im + j, hi_re + j, hi_im + j, w_re + j, w_im + j, count - j);
+}
+
+__attribute__((target("avx2,fma")))
+static void double_batch_arith_avx2(const int op, const double *a_re, const double *a_im,
+                                    const double *b_re, const double *b_im,
+                                    double *out_re, double *out_im, const size_t count)
+{
+    size_t j = 0;
+    for (; j + 4 <= count; j += 4)
+    {
+        const __m256d ar = _mm256_loadu_pd(a_re + j);
+        const __m256d ai = _mm256_loadu_pd(a_im + j);
+        const __m256d br = _mm256_loadu_pd(b_re + j);
+        const __m256d bi = _mm256_loadu_pd(b_im + j);
+        __m256d r, i;
+        if (op == 0)
+        {
+            r = _mm256_add_pd(ar, br);
+            i = _mm256_add_pd(ai, bi);
+        }
+        else if (op == 1)
+        {
+            r = _mm256_sub_pd(ar, br);
+            i = _mm256_sub_pd(ai, bi);
+        }
+        else
+        {
+            r = _mm256_fmsub_pd(ar, br, _mm256_mul_pd(ai, bi));
+            i = _mm256_fmadd_pd(ar, bi, _mm256_mul_pd(ai, br));
+        }
+        _mm256_storeu_pd(out_re + j, r);
+        _mm256_storeu_pd(out_im + j, i);
+    }
+    double_batch_arith_scalar(op, a_re + j, a_im + j, b_re + j, b_im + j, out_re + j, out_im + j, count - j);
+}
+#endif
+
+static void double_batch_butterflies(const double_batch_backend backend,
+                                     double *lo_re, double *lo_im, double *hi_re, double *hi_im,
+                                     const double *w_re, const double *w_im, const size_t count)
+{
+#if defined(__x86_64__) && defined(USE_ASM)
+    if (backend == double_batch_backend_avx2)
+    {
+        double_batch_butterflies_avx2(lo_re, lo_im, hi_re, hi_im, w_re, w_im, count);
+        return;
+    }
+#else
+    UNUSED(backend);
+#endif
+    double_batch_butterflies_scalar(lo_re, lo_im, hi_re, hi_im, w_re, w_im, count);
+}
+
+/* elements per parallel work item */
+static const size_t double_batch_block_size = 1024;
+
+static void double_batch_arith(const double_batch_backend backend, const int op,
+                               const Double_batch &a, const Double_batch &b, Double_batch &out)
+{
+    ASSERT(a.size() == b.size());
+    ASSERT(out.size() == a.size());
+    const size_t num_blocks = (a.size() + double_batch_block_size - 1) / double_batch_block_size;
+
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+    for (size_t blk = 0; blk < num_blocks; ++blk)
+    {
+        const size_t begin = blk * double_batch_block_size;
+        const size_t count = std::min(double_batch_block_size, a.size() - begin);
+#if defined(__x86_64__) && defined(USE_ASM)
+        if (backend == double_batch_backend_avx2)
+        {
+            double_batch_arith_avx2(op, &a.re[begin], &a.im[begin], &b.re[begin], &b.im[begin],
+                                    &out.re[begin], &out.im[begin], count);
+            continue;
+        }
+#else
+        UNUSED(backend);
+#endif
+        double_batch_arith_scalar(op, &a.re[begin], &a.im[begin], &b.re[begin], &b.im[begin],
+                                  &out.re[begin], &out.im[begin], count);
+    }
+}
+
+Double_batch::Double_batch(const size_t size, const double_batch_backend backend) :
+    re(size, 0.0), im(size, 0.0), batch_backend(backend)
+{
+    ASSERT(double_batch_backend_supported(backend));
+}
+
+Double_batch::Double_batch(const std::vector<Double> &v, const double_batch_backend backend) :
+    re(v.size()), im(v.size()), batch_backend(backend)
+{
+    ASSERT(double_batch_backend_supported(backend));
+    for (size_t i = 0; i < v.size(); ++i)
+    {
+        this->re[i] = v[i].val.real();
+        this->im[i] = v[i].val.imag();
+    }
+}
+
+void Double_batch::set(const size_t i, const Double &el)
+{
+    this->re[i] = el.val.real();
+    this->im[i] = el.val.imag();
+}
+
+std::vector<Double> Double_batch::to_vector() const
+{
+    std::vector<Double> result;
+    result.reserve(this->size());
+    for (size_t i = 0; i < this->size(); ++i)
+    {
+        result.emplace_back(Double(this->re[i], this->im[i]));
+    }
+    return result;
+}
+
+Double_batch Double_batch::operator+(const Double_batch &other) const
+{
+    Double_batch result(this->size(), this->batch_backend);
+    double_batch_arith(this->batch_backend, 0, *this, other, result);
+    return result;
+}
+
+Double_batch Double_batch::operator-(const Double_batch &other) const
+{
+    Double_batch result(this->size(), this->batch_backend);
+    double_batch_arith(this->batch_backend, 1, *this, other, result);
+    return result;
+}
+
+Double_batch Double_batch::operator*(const Double_batch &other) const
+{
+    Double_batch result(this->size(), this->batch_backend);
+    double_batch_arith(this->batch_backend, 2, *this, other, result);
+    return result;
+}
+
+Double_batch& Double_batch::operator+=(const Double_batch &other)
+{
+    double_batch_arith(this->batch_backend, 0, *this, other, *this);
+    return *this;
+}
+
+Double_batch& Double_batch::operator-=(const Double_batch &other)
+{
+    double_batch_arith(this->batch_backend, 1, *this, other, *this);
+    return *this;
+}
+
+Double_batch& Double_batch::operator*=(const Double_batch &other)
+{
+    double_batch_arith(this->batch_backend, 2, *this, other, *this);
+    return *this;
+}
+
+void Double_batch::FFT(const Double_fft_twiddles &twiddles)
+{
+    const size_t n = this->size();
+    ASSERT(twiddles.size() == n);
+    if (n <= 1)
+    {
+        return;
+    }
+    const size_t logn = log2(n);
+
+    for (size_t k = 0; k < n; ++k)
+    {
+        const size_t rk = bitreverse(k, logn);
+        if (k < rk)
+        {
+            std::swap(this->re[k], this->re[rk]);
+            std::swap(this->im[k], this->im[rk]);
+        }
+    }
+
+    for (size_t m = 1; m < n; m *= 2)
+    {
+        /* n/2 butterflies per stage, in items of up to a block of one half */
+        const size_t item = std::min(m, double_batch_block_size);
+        const size_t num_items = n / 2 / item;
+
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+        for (size_t t = 0; t < num_items; ++t)
+        {
+            const size_t k = (t * item) / m * 2 * m;
+            const size_t j = (t * item) % m;
+            double_batch_butterflies(this->batch_backend,
+                                     &this->re[k + j], &this->im[k + j],
+                                     &this->re[k + j + m], &this->im[k + j + m],
+                                     &twiddles.re[m - 1 + j], &twiddles.im[m - 1 + j], item);
+        }
+    }
+}
+
+void Double_batch::FFT()
+{
+    this->FFT(Double_fft_twiddles(this->size()));
+}
+
+void Double_batch::iFFT(const Double_fft_twiddles &twiddles)
+{
+    /* FFT with omega^-1 is the conjugate of the FFT of the conjugate */
+    const size_t n = this->size();
+    for (size_t i = 0; i < n; ++i)
+    {
+        this->im[i] = -this->im[i];
+    }
+
+    this->FFT(twiddles);
+
+    const double scale = 1.0 / n;
+    for (size_t i = 0; i < n; ++i)
+    {
+        this->re[i] *= scale;
+        this->im[i] *= -scale;
+    }
+}
+
+void Double_batch::iFFT()
+{
+    this->iFFT(Double_fft_twiddles(this->size()));
+}
+
+} // libff
@@ -0,0 +1,104 @@
+/** @file
+ *****************************************************************************
+
+ Declaration of a batch of complex numbers stored as split real and
+ imaginary arrays, for floating-point FFTs without per-element Double
+ objects.
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef DOUBLE_BATCH_HPP_
+#define DOUBLE_BATCH_HPP_
+
+#include <cstddef>
+#include <vector>
+
+#include <libff/common/double.hpp>
+
+namespace libff {
+
+enum double_batch_backend {
+    double_batch_backend_scalar,
+    /* AVX2 and FMA, 4 elements per instruction */
+    double_batch_backend_avx2
+};
+
+/* Whether this build, and the CPU it runs on, support backend. */
+bool double_batch_backend_supported(const double_batch_backend backend);
+
+/* The fastest supported backend, detected with CPUID on first use. */
+double_batch_backend double_batch_default_backend();
+
+/**
+ * The twiddle factors of a radix-2 FFT of size n (a power of 2) with root
+ * of unity omega = get_root_of_unity<Double>(n): for the stage combining
+ * halves of length m, the m factors omega_{2m}^j, j < m, are stored
+ * contiguously at offset m - 1. Each factor is computed directly with cos
+ * and sin, so errors do not accumulate along the table. A table can be
+ * reused by all FFTs of its size.
+ */
+class Double_fft_twiddles {
+public:
+    explicit Double_fft_twiddles(const size_t n);
+
+    size_t size() const { return this->n; }
+
+    size_t n;
+    std::vector<double> re;
+    std::vector<double> im;
+};
+
+/**
+ * A vector of complex numbers with the real parts in one array and the
+ * imaginary parts in another, so that arithmetic and FFT butterflies run 4
+ * elements per AVX2 instruction. Unlike Double, no operation counters are
+ * touched.
+ */
+class Double_batch {
+public:
+    /* size zeros */
+    explicit Double_batch(const size_t size, const double_batch_backend backend = double_batch_default_backend());
+    explicit Double_batch(const std::vector<Double> &v, const double_batch_backend backend = double_batch_default_backend());
+
+    size_t size() const { return this->re.size(); }
+    double_batch_backend backend() const { return this->batch_backend; }
+
+    Double get(const size_t i) const { return Double(this->re[i], this->im[i]); }
+    void set(const size_t i, const Double &el);
+
+    std::vector<Double> to_vector() const;
+
+    Double_batch operator+(const Double_batch &other) const;
+    Double_batch operator-(const Double_batch &other) const;
+    Double_batch operator*(const Double_batch &other) const;
+    Double_batch& operator+=(const Double_batch &other);
+    Double_batch& operator-=(const Double_batch &other);
+    Double_batch& operator*=(const Double_batch &other);
+
+    /**
+     * In place, a[i] = \sum_j a[j] omega^(i*j) with omega =
+     * get_root_of_unity<Double>(size()), the transform computed by the
+     * radix-2 FFT of libfqfft on vectors of Double. size() must be a power
+     * of 2. Under MULTICORE the butterflies of each stage are split across
+     * threads.
+     */
+    void FFT(const Double_fft_twiddles &twiddles);
+    void FFT();
+    /* The inverse of FFT(), including the division by size(). */
+    void iFFT(const Double_fft_twiddles &twiddles);
+    void iFFT();
+
+    std::vector<double> re;
+    std::vector<double> im;
+
+private:
+    double_batch_backend batch_backend;
+};
+
+} // libff
+
+#endif // DOUBLE_BATCH_HPP_
@@ -0,0 +1,122 @@
+/** @file
+ *****************************************************************************
+
+ Implementation of helpers for huge pages and first-touch page placement.
+
+ See huge_pages.hpp .
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#include <algorithm>
+#include <cstdint>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include <libff/common/huge_pages.hpp>
+#include <libff/common/utils.hpp>
+
+namespace libff {
+
+huge_page_mode huge_pages = huge_pages_off;
+
+void* map_huge_pages(size_t &bytes)
+{
+#ifdef __linux__
+    if (huge_pages == huge_pages_off)
+    {
+        return nullptr;
+    }
+
+    const size_t mapped_bytes = (bytes + huge_page_size - 1) / huge_page_size * huge_page_size;
+#ifdef MAP_HUGETLB
+    if (huge_pages == huge_pages_hugetlb)
+    {
+        void *p = mmap(nullptr, mapped_bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (p != MAP_FAILED)
+        {
+            bytes = mapped_bytes;
+            return p;
+        }
+    }
+#endif
+
+    void *p = mmap(nullptr, mapped_bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED)
+    {
+        return nullptr;
+    }
+    advise_huge_pages(p, mapped_bytes);
+    bytes = mapped_bytes;
+    return p;
+#else
+    UNUSED(bytes);
+    return nullptr;
+#endif
+}
+
+void unmap_huge_pages(void *data, const size_t bytes)
+{
+#ifdef __linux__
+    munmap(data, bytes);
+#else
+    UNUSED(data, bytes);
+#endif
+}
+
+bool advise_huge_pages(void *data, const size_t bytes)
+{
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    if (huge_pages == huge_pages_off)
+    {
+        return false;
+    }
+
+    /* only whole huge pages can be backed by one */
+    const uintptr_t start = reinterpret_cast<uintptr_t>(data);
+    const uintptr_t begin = (start + huge_page_size - 1) / huge_page_size * huge_page_size;
+    const uintptr_t end = (start + bytes) / huge_page_size * huge_page_size;
+    if (begin >= end)
+    {
+        return false;
+    }
+
+    return madvise(reinterpret_cast<void*>(begin), end - begin, MADV_HUGEPAGE) == 0;
+#else
+    UNUSED(data, bytes);
+    return false;
+#endif
+}
+
+void first_touch_pages(void *data, const size_t bytes, const size_t num_parts)
+{
+#ifdef __linux__
+    const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#else
+    const size_t page_size = 4096;
+#endif
+    volatile char *bytes_ptr = static_cast<volatile char*>(data);
+    const size_t parts = (num_parts == 0 || bytes < num_parts ? 1 : num_parts);
+    const size_t part_size = bytes / parts;
+
+#ifdef MULTICORE
+#pragma omp parallel for schedule(static)
+#endif
+    for (size_t part = 0; part < parts; ++part)
+    {
+        const size_t begin = part * part_size;
+        const size_t end = (part == parts - 1 ? bytes : begin + part_size);
+        for (size_t i = begin; i < end; i += page_size)
+        {
+            bytes_ptr[i] = 0;
+        }
+    }
+}
+
+} // libff
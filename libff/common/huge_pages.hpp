@@ -0,0 +1,75 @@
+/** @file
+ *****************************************************************************
+
+ Declaration of helpers for backing large buffers with huge pages and for
+ placing their pages on NUMA nodes by first touch.
+
+ Large point vectors, window tables and MSM scratch memory are walked with
+ little locality, so 4 KiB pages cost many TLB misses. On multi-socket
+ machines, where a page lives is decided by the thread that first writes
+ it; touching a vector in the same contiguous parts that multi_exp hands to
+ its threads keeps each part on the node of the thread that reads it (with
+ threads pinned, e.g., OMP_PROC_BIND=close).
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef HUGE_PAGES_HPP_
+#define HUGE_PAGES_HPP_
+
+#include <cstddef>
+#include <vector>
+
+namespace libff {
+
+enum huge_page_mode {
+    huge_pages_off,
+    /* madvise(MADV_HUGEPAGE): transparent huge pages where the kernel has them */
+    huge_pages_transparent,
+    /* MAP_HUGETLB from the hugetlbfs pool for memory libff maps itself, falling back to transparent */
+    huge_pages_hugetlb
+};
+
+/* Off by default; only Linux honors the other modes. */
+extern huge_page_mode huge_pages;
+
+const size_t huge_page_size = 1ul << 21;
+
+/**
+ * Maps at least bytes of fresh memory according to huge_pages, rounding
+ * bytes up to a whole number of huge pages. Returns nullptr (and leaves bytes
+ * as is) when huge pages are off or the mapping fails.
+ */
+void* map_huge_pages(size_t &bytes);
+void unmap_huge_pages(void *data, const size_t bytes);
+
+/**
+ * Advises the kernel to back the whole huge pages inside [data, data+bytes)
+ * with transparent huge pages, if huge_pages is not off. Memory that has
+ * not been touched yet is then faulted in as huge pages.
+ */
+bool advise_huge_pages(void *data, const size_t bytes);
+
+/**
+ * Writes one byte per page of [data, data+bytes), split into num_parts
+ * contiguous parts of equal size; under MULTICORE part i is touched by
+ * thread i of a static schedule, like the chunks of multi_exp.
+ */
+void first_touch_pages(void *data, const size_t bytes, const size_t num_parts);
+
+/**
+ * Replaces the contents of v by size default-constructed elements in fresh
+ * storage that was advised for huge pages and first touched in num_parts
+ * parts (e.g., the chunks passed to multi_exp) before construction.
+ */
+template<typename T>
+void resize_with_huge_pages(std::vector<T> &v, const size_t size, const size_t num_parts);
+
+} // libff
+
+#include <libff/common/huge_pages.tcc>
+
+#endif // HUGE_PAGES_HPP_
@@ -0,0 +1,34 @@
+/** @file
+ *****************************************************************************
+
+ Implementation of templatized helpers for huge-page backed vectors.
+
+ See huge_pages.hpp .
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef HUGE_PAGES_TCC_
+#define HUGE_PAGES_TCC_
+
+namespace libff {
+
+template<typename T>
+void resize_with_huge_pages(std::vector<T> &v, const size_t size, const size_t num_parts)
+{
+    std::vector<T>().swap(v);
+    v.reserve(size);
+
+    /* the reserved storage is not touched until the elements are constructed */
+    advise_huge_pages(v.data(), size * sizeof(T));
+    first_touch_pages(v.data(), size * sizeof(T), num_parts);
+
+    v.resize(size);
+}
+
+} // libff
+
+#endif // HUGE_PAGES_TCC_
@@ -0,0 +1,143 @@
+/** @file
+ *****************************************************************************
+
+ Implementation of a bit vector packed into 64-bit words.
+
+ See packed_bit_vector.hpp .
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#include <algorithm>
+
+#include <libff/common/assert.hpp>
+#include <libff/common/packed_bit_vector.hpp>
+
+namespace libff {
+
+const size_t packed_bit_vector::word_bits;
+
+/* the low count bits set, count <= 64 */
+static inline uint64_t low_bits_mask(const size_t count)
+{
+    return (count >= 64 ? ~0ull : (1ull << count) - 1);
+}
+
+packed_bit_vector::packed_bit_vector(const size_t size, const bool value) :
+    data((size + word_bits - 1) / word_bits, value ? ~0ull : 0ull), num_bits(size)
+{
+    if (value && size % word_bits != 0)
+    {
+        this->data.back() &= low_bits_mask(size % word_bits);
+    }
+}
+
+packed_bit_vector::packed_bit_vector(const bit_vector &v) :
+    data((v.size() + word_bits - 1) / word_bits, 0), num_bits(v.size())
+{
+    bit_vector::const_iterator it = v.begin();
+    for (size_t w = 0; w < this->data.size(); ++w)
+    {
+        /* assemble each word in a register */
+        const size_t count = std::min(word_bits, this->num_bits - w * word_bits);
+        uint64_t word = 0;
+        for (size_t j = 0; j < count; ++j, ++it)
+        {
+            word |= (*it ? 1ull : 0ull) << j;
+        }
+        this->data[w] = word;
+    }
+}
+
+void packed_bit_vector::set(const size_t i, const bool value)
+{
+    ASSERT(i < this->num_bits);
+    const uint64_t bit = 1ull << (i % word_bits);
+    if (value)
+    {
+        this->data[i / word_bits] |= bit;
+    }
+    else
+    {
+        this->data[i / word_bits] &= ~bit;
+    }
+}
+
+uint64_t packed_bit_vector::get_bits(const size_t pos, const size_t count) const
+{
+    ASSERT(count <= word_bits);
+    if (count == 0 || pos >= this->num_bits)
+    {
+        return 0;
+    }
+
+    const size_t word = pos / word_bits;
+    const size_t shift = pos % word_bits;
+    uint64_t bits = this->data[word] >> shift;
+    if (shift != 0 && shift + count > word_bits && word + 1 < this->data.size())
+    {
+        bits |= this->data[word + 1] << (word_bits - shift);
+    }
+    return bits & low_bits_mask(count);
+}
+
+void packed_bit_vector::append_bits(const uint64_t bits, const size_t count)
+{
+    ASSERT(count <= word_bits);
+    if (count == 0)
+    {
+        return;
+    }
+
+    const uint64_t masked = bits & low_bits_mask(count);
+    const size_t shift = this->num_bits % word_bits;
+    if (shift == 0)
+    {
+        this->data.emplace_back(masked);
+    }
+    else
+    {
+        this->data.back() |= masked << shift;
+        if (shift + count > word_bits)
+        {
+            this->data.emplace_back(masked >> (word_bits - shift));
+        }
+    }
+    this->num_bits += count;
+}
+
+void packed_bit_vector::resize(const size_t size)
+{
+    this->data.resize((size + word_bits - 1) / word_bits, 0);
+    if (size < this->num_bits && size % word_bits != 0)
+    {
+        this->data.back() &= low_bits_mask(size % word_bits);
+    }
+    this->num_bits = size;
+}
+
+bit_vector packed_bit_vector::to_bit_vector() const
+{
+    bit_vector result(this->num_bits);
+    bit_vector::iterator it = result.begin();
+    for (size_t w = 0; w < this->data.size(); ++w)
+    {
+        const size_t count = std::min(word_bits, this->num_bits - w * word_bits);
+        const uint64_t word = this->data[w];
+        for (size_t j = 0; j < count; ++j, ++it)
+        {
+            *it = (word >> j) & 1;
+        }
+    }
+    return result;
+}
+
+bool packed_bit_vector::operator==(const packed_bit_vector &other) const
+{
+    return (this->num_bits == other.num_bits && this->data == other.data);
+}
+
+} // libff
@@ -0,0 +1,68 @@
+/** @file
+ *****************************************************************************
+
+ Declaration of a bit vector packed into 64-bit words.
+
+ Unlike bit_vector (std::vector<bool>), whose layout is unspecified, the
+ bits are exposed as words, so that packing bits into field elements and
+ unpacking them again can move a limb at a time instead of a bit at a time.
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef PACKED_BIT_VECTOR_HPP_
+#define PACKED_BIT_VECTOR_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <libff/common/utils.hpp>
+
+namespace libff {
+
+/**
+ * Bit i is bit (i % 64) of word i / 64. Bits of the last word past size()
+ * are always zero.
+ */
+class packed_bit_vector {
+public:
+    static const size_t word_bits = 64;
+
+    packed_bit_vector() : num_bits(0) {};
+    explicit packed_bit_vector(const size_t size, const bool value = false);
+    explicit packed_bit_vector(const bit_vector &v);
+
+    size_t size() const { return this->num_bits; }
+    bool empty() const { return this->num_bits == 0; }
+
+    bool operator[](const size_t i) const { return (this->data[i / word_bits] >> (i % word_bits)) & 1; }
+    void set(const size_t i, const bool value);
+
+    /* bits [pos, pos+count) as the low bits of a word, count <= 64; bits past size() read as zero */
+    uint64_t get_bits(const size_t pos, const size_t count) const;
+    /* appends the low count bits of bits, count <= 64 */
+    void append_bits(const uint64_t bits, const size_t count);
+    void push_back(const bool value) { this->append_bits(value ? 1 : 0, 1); }
+
+    void resize(const size_t size);
+    void reserve(const size_t size) { this->data.reserve((size + word_bits - 1) / word_bits); }
+
+    const std::vector<uint64_t>& words() const { return this->data; }
+
+    bit_vector to_bit_vector() const;
+
+    bool operator==(const packed_bit_vector &other) const;
+    bool operator!=(const packed_bit_vector &other) const { return !(*this == other); }
+
+private:
+    std::vector<uint64_t> data;
+    size_t num_bits;
+};
+
+} // libff
+
+#endif // PACKED_BIT_VECTOR_HPP_
@@ -15,6 +15,7 @@
 #include <cstdio>
 #include <ctime>
 #include <list>
+#include <mutex>
 #include <stdexcept>
 #include <vector>
 
@@ -62,18 +63,28 @@ void start_profiling()
 }
 
 std::map<std::string, size_t> invocation_counts;
-std::map<std::string, long long> enter_times;
 std::map<std::string, long long> last_times;
 std::map<std::string, long long> cumulative_times;
 //TODO: Instead of analogous maps for time and cpu_time, use a single struct-valued map
-std::map<std::string, long long> enter_cpu_times;
 std::map<std::string, long long> last_cpu_times;
 std::map<std::pair<std::string, std::string>, long long> op_counts;
 std::map<std::pair<std::string, std::string>, long long> cumulative_op_counts; // ((msg, data_point), value)
     // TODO: Convert op_counts and cumulative_op_counts from pair to structs
-size_t indentation = 0;
 
-std::vector<std::string> block_names;
+/*
+  blocks may be entered from tasks of the task scheduler or from OpenMP
+  threads, so the open blocks, with their enter times, and the indentation
+  are per thread; two threads in a block of the same name time it separately
+*/
+struct open_block {
+    std::string name;
+    long long time;
+    long long cpu_time;
+};
+thread_local std::vector<open_block> open_blocks;
+thread_local size_t indentation = 0;
+/* guards the shared maps of times and counts */
+static std::mutex block_times_mutex;
 
 std::list<std::pair<std::string, long long*> > op_data_points = {
 #ifdef PROFILE_OP_COUNTS
@@ -249,33 +260,27 @@ void enter_block(const std::string &msg, const bool indent)
         return;
     }
 
-    block_names.emplace_back(msg);
     long long t = get_nsec_time();
-    enter_times[msg] = t;
     long long cpu_t = get_nsec_cpu_time();
-    enter_cpu_times[msg] = cpu_t;
+    open_blocks.push_back({ msg, t, cpu_t });
 
     if (inhibit_profiling_info)
     {
         return;
     }
 
-#ifdef MULTICORE
-#pragma omp critical
-#endif
-    {
-        op_profiling_enter(msg);
+    std::lock_guard<std::mutex> lock(block_times_mutex);
+    op_profiling_enter(msg);
 
-        print_indent();
-        printf("(enter) %-35s\t", msg.c_str());
-        print_times_from_last_and_start(t, t, cpu_t, cpu_t);
-        printf("\n");
-        fflush(stdout);
+    print_indent();
+    printf("(enter) %-35s\t", msg.c_str());
+    print_times_from_last_and_start(t, t, cpu_t, cpu_t);
+    printf("\n");
+    fflush(stdout);
 
-        if (indent)
-        {
-            ++indentation;
-        }
+    if (indent)
+    {
+        ++indentation;
     }
 }
 
@@ -286,19 +291,33 @@ void leave_block(const std::string &msg, const bool indent)
         return;
     }
 
+    long long t = get_nsec_time();
+    long long cpu_t = get_nsec_cpu_time();
+
+    /* the innermost open block of that name on this thread */
+    size_t i = open_blocks.size();
+    while (i > 0 && open_blocks[i-1].name != msg)
+    {
+        --i;
+    }
 #ifndef MULTICORE
-    ASSERT(*(--block_names.end()) == msg);
+    ASSERT(i == open_blocks.size());
 #endif
-    block_names.pop_back();
+    if (i == 0)
+    {
+        /* entered on another thread; there is no enter time to measure from */
+        return;
+    }
+    const long long enter_t = open_blocks[i-1].time;
+    const long long enter_cpu_t = open_blocks[i-1].cpu_time;
+    open_blocks.erase(open_blocks.begin() + (i-1));
 
+    std::lock_guard<std::mutex> lock(block_times_mutex);
     ++invocation_counts[msg];
 
-    long long t = get_nsec_time();
-    last_times[msg] = (t - enter_times[msg]);
-    cumulative_times[msg] += (t - enter_times[msg]);
-
-    long long cpu_t = get_nsec_cpu_time();
-    last_cpu_times[msg] = (cpu_t - enter_cpu_times[msg]);
+    last_times[msg] = (t - enter_t);
+    cumulative_times[msg] += (t - enter_t);
+    last_cpu_times[msg] = (cpu_t - enter_cpu_t);
 
 #ifdef PROFILE_OP_COUNTS
     for (std::pair<std::string, long long*> p : op_data_points)
@@ -312,22 +331,17 @@ void leave_block(const std::string &msg, const bool indent)
         return;
     }
 
-#ifdef MULTICORE
-#pragma omp critical
-#endif
+    if (indent && indentation > 0)
     {
-        if (indent)
-        {
-            --indentation;
-        }
-
-        print_indent();
-        printf("(leave) %-35s\t", msg.c_str());
-        print_times_from_last_and_start(t, enter_times[msg], cpu_t, enter_cpu_times[msg]);
-        print_op_profiling(msg);
-        printf("\n");
-        fflush(stdout);
+        --indentation;
     }
+
+    print_indent();
+    printf("(leave) %-35s\t", msg.c_str());
+    print_times_from_last_and_start(t, enter_t, cpu_t, enter_cpu_t);
+    print_op_profiling(msg);
+    printf("\n");
+    fflush(stdout);
 }
 
 void print_mem(const std::string &s)
@@ -40,6 +40,12 @@ void print_cumulative_time_entry(const std::string &key, const long long factor=
 void print_cumulative_times(const long long factor=1);
 void print_cumulative_op_counts(const bool only_fq=false);
 
+/**
+ * Blocks may be entered and left from several threads at once (e.g., by
+ * tasks of task_scheduler). Open blocks, their enter times and the
+ * indentation are kept per thread, so a block must be left on the thread
+ * that entered it; the maps of times and counts are shared.
+ */
 void enter_block(const std::string &msg, const bool indent=true);
 void leave_block(const std::string &msg, const bool indent=true);
 
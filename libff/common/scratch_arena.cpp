@@ -0,0 +1,243 @@
+/** @file
+ *****************************************************************************
+
+ Implementation of per-thread scratch arenas.
+
+ See scratch_arena.hpp .
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#include <algorithm>
+#include <cstdint>
+#include <mutex>
+#include <new>
+
+#include <libff/common/assert.hpp>
+#include <libff/common/huge_pages.hpp>
+#include <libff/common/scratch_arena.hpp>
+
+namespace libff {
+
+const size_t scratch_arena::min_chunk_size;
+
+/*
+  all live arenas, for reset_all() and release_all(). Never destroyed: a
+  thread joined during static destruction (e.g., a worker of
+  task_scheduler::global(), which can exist before the registry does)
+  unregisters its arena after the registry would otherwise be gone.
+*/
+static std::mutex& scratch_arena_registry_mutex()
+{
+    static std::mutex *mutex = new std::mutex;
+    return *mutex;
+}
+
+static std::vector<scratch_arena*>& scratch_arena_registry()
+{
+    static std::vector<scratch_arena*> *registry = new std::vector<scratch_arena*>;
+    return *registry;
+}
+
+scratch_arena::scratch_arena() : current(0)
+{
+    std::lock_guard<std::mutex> lock(scratch_arena_registry_mutex());
+    scratch_arena_registry().emplace_back(this);
+}
+
+scratch_arena::~scratch_arena()
+{
+    {
+        std::lock_guard<std::mutex> lock(scratch_arena_registry_mutex());
+        std::vector<scratch_arena*> &registry = scratch_arena_registry();
+        registry.erase(std::remove(registry.begin(), registry.end(), this), registry.end());
+    }
+    this->release();
+}
+
+scratch_arena& scratch_arena::thread_arena()
+{
+    static thread_local scratch_arena arena;
+    return arena;
+}
+
+void* scratch_arena::allocate(const size_t bytes, const size_t alignment)
+{
+    ASSERT(alignment > 0 && (alignment & (alignment - 1)) == 0);
+
+    for (; this->current < this->chunks.size(); ++this->current)
+    {
+        chunk &c = this->chunks[this->current];
+        const uintptr_t start = reinterpret_cast<uintptr_t>(c.data) + c.used;
+        const size_t padding = (alignment - start % alignment) % alignment;
+        if (c.used + padding + bytes <= c.size)
+        {
+            c.used += padding + bytes;
+            return c.data + (c.used - bytes);
+        }
+    }
+
+    const size_t last_size = (this->chunks.empty() ? 0 : this->chunks.back().size);
+    this->chunks.emplace_back(allocate_chunk(std::max(std::max(min_chunk_size, 2 * last_size), bytes + alignment)));
+    this->current = this->chunks.size() - 1;
+    return this->allocate(bytes, alignment);
+}
+
+scratch_arena::mark scratch_arena::get_mark() const
+{
+    mark m;
+    m.chunk = this->current;
+    m.used = (this->current < this->chunks.size() ? this->chunks[this->current].used : 0);
+    return m;
+}
+
+void scratch_arena::rewind(const mark &m)
+{
+    if (m.chunk >= this->chunks.size())
+    {
+        /* nothing was allocated before the mark */
+        for (chunk &c : this->chunks)
+        {
+            c.used = 0;
+        }
+        this->current = 0;
+        return;
+    }
+
+    for (size_t i = m.chunk + 1; i < this->chunks.size(); ++i)
+    {
+        this->chunks[i].used = 0;
+    }
+    this->chunks[m.chunk].used = m.used;
+    this->current = m.chunk;
+}
+
+void scratch_arena::reset()
+{
+    if (this->chunks.size() > 1)
+    {
+        size_t total = 0;
+        for (const chunk &c : this->chunks)
+        {
+            total += c.size;
+        }
+        this->release();
+        this->chunks.emplace_back(allocate_chunk(total));
+    }
+    else if (!this->chunks.empty())
+    {
+        this->chunks[0].used = 0;
+    }
+    this->current = 0;
+}
+
+void scratch_arena::release()
+{
+    for (const chunk &c : this->chunks)
+    {
+        free_chunk(c);
+    }
+    this->chunks.clear();
+    this->current = 0;
+}
+
+void scratch_arena::trim(const size_t capacity)
+{
+    size_t total = this->capacity();
+    while (total > capacity && !this->chunks.empty() && this->chunks.back().used == 0)
+    {
+        total -= this->chunks.back().size;
+        free_chunk(this->chunks.back());
+        this->chunks.pop_back();
+    }
+
+    if (this->current >= this->chunks.size())
+    {
+        this->current = (this->chunks.empty() ? 0 : this->chunks.size() - 1);
+    }
+}
+
+size_t scratch_arena::capacity() const
+{
+    size_t total = 0;
+    for (const chunk &c : this->chunks)
+    {
+        total += c.size;
+    }
+    return total;
+}
+
+size_t scratch_arena::used() const
+{
+    size_t total = 0;
+    for (const chunk &c : this->chunks)
+    {
+        total += c.used;
+    }
+    return total;
+}
+
+void scratch_arena::reset_all()
+{
+    std::lock_guard<std::mutex> lock(scratch_arena_registry_mutex());
+    for (scratch_arena *arena : scratch_arena_registry())
+    {
+        arena->reset();
+    }
+}
+
+void scratch_arena::release_all()
+{
+    std::lock_guard<std::mutex> lock(scratch_arena_registry_mutex());
+    for (scratch_arena *arena : scratch_arena_registry())
+    {
+        arena->release();
+    }
+}
+
+scratch_arena::chunk scratch_arena::allocate_chunk(const size_t size)
+{
+    chunk c;
+    c.used = 0;
+    c.mapped = false;
+
+    size_t mapped_size = size;
+    void *p = (size >= huge_page_size ? map_huge_pages(mapped_size) : nullptr);
+    if (p != nullptr)
+    {
+        c.data = static_cast<char*>(p);
+        c.size = mapped_size;
+        c.mapped = true;
+        return c;
+    }
+
+    c.data = static_cast<char*>(::operator new(size));
+    c.size = size;
+    return c;
+}
+
+void scratch_arena::free_chunk(const chunk &c)
+{
+    if (c.mapped)
+    {
+        unmap_huge_pages(c.data, c.size);
+        return;
+    }
+    ::operator delete(c.data);
+}
+
+scratch_scope::scratch_scope() :
+    arena(scratch_arena::thread_arena()),
+    start(arena.get_mark())
+{
+}
+
+scratch_scope::~scratch_scope()
+{
+    this->arena.rewind(this->start);
+}
+
+} // libff
@@ -0,0 +1,141 @@
+/** @file
+ *****************************************************************************
+
+ Declaration of per-thread scratch arenas for short-lived temporaries.
+
+ Hot paths (multi-exponentiation buckets, wNAF digits, ...) draw their
+ temporaries from the arena of the calling thread instead of the global
+ heap. Allocation is a pointer bump and deallocation is a no-op; memory is
+ handed back in bulk when the enclosing scratch_scope ends, so a
+ long-running process neither contends on the allocator across threads nor
+ fragments its heap with per-call buffers. Chunks of at least
+ huge_page_size bytes are mapped according to huge_pages (see
+ huge_pages.hpp); smaller ones, including a first chunk of the default
+ min_chunk_size, come from the heap and are not. Scratch memory is
+ therefore only huge-page backed once an arena has grown past
+ huge_page_size, e.g., for the buckets of a large multi-exponentiation.
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef SCRATCH_ARENA_HPP_
+#define SCRATCH_ARENA_HPP_
+
+#include <cstddef>
+#include <vector>
+
+namespace libff {
+
+class scratch_arena {
+public:
+    /* A position in the arena, to rewind to. */
+    struct mark {
+        size_t chunk;
+        size_t used;
+    };
+
+    static const size_t min_chunk_size = 1ul << 20;
+
+    scratch_arena();
+    ~scratch_arena();
+    scratch_arena(const scratch_arena &other) = delete;
+    scratch_arena& operator=(const scratch_arena &other) = delete;
+
+    /* The arena of the calling thread. */
+    static scratch_arena& thread_arena();
+
+    void* allocate(const size_t bytes, const size_t alignment);
+
+    mark get_mark() const;
+    /* Rewinds to m; everything allocated since m becomes free again. */
+    void rewind(const mark &m);
+
+    /**
+     * Rewinds to the start and, if the arena grew past one chunk, replaces
+     * its chunks by a single one of their total size, so the next round of
+     * the same work fits without growing.
+     */
+    void reset();
+    /* Returns all memory to the system. */
+    void release();
+    /**
+     * Returns unused chunks to the system, most recently added first, while
+     * the capacity exceeds the given one; e.g., to give back what a call
+     * grew the arena by, keeping what it held before.
+     */
+    void trim(const size_t capacity);
+
+    size_t capacity() const;
+    size_t used() const;
+
+    /**
+     * reset() or release() the arenas of all threads. Only call these while
+     * no thread is using scratch memory, e.g., between proofs.
+     */
+    static void reset_all();
+    static void release_all();
+
+private:
+    struct chunk {
+        char *data;
+        size_t size;
+        size_t used;
+        bool mapped;
+    };
+
+    std::vector<chunk> chunks;
+    size_t current;
+
+    static chunk allocate_chunk(const size_t size);
+    static void free_chunk(const chunk &c);
+};
+
+/**
+ * Rewinds the thread's arena to where it was at construction. Temporaries
+ * drawn from the arena must not outlive the scope they were created in.
+ */
+class scratch_scope {
+public:
+    scratch_scope();
+    ~scratch_scope();
+    scratch_scope(const scratch_scope &other) = delete;
+    scratch_scope& operator=(const scratch_scope &other) = delete;
+
+private:
+    scratch_arena &arena;
+    scratch_arena::mark start;
+};
+
+/* A standard allocator drawing from the arena of the constructing thread. */
+template<typename T>
+class scratch_allocator {
+public:
+    typedef T value_type;
+
+    scratch_allocator() : arena(&scratch_arena::thread_arena()) {};
+    template<typename U>
+    scratch_allocator(const scratch_allocator<U> &other) : arena(other.arena) {};
+
+    T* allocate(const size_t count)
+    {
+        return static_cast<T*>(arena->allocate(count * sizeof(T), alignof(T)));
+    }
+    void deallocate(T*, const size_t) {};
+
+    template<typename U>
+    bool operator==(const scratch_allocator<U> &other) const { return arena == other.arena; }
+    template<typename U>
+    bool operator!=(const scratch_allocator<U> &other) const { return arena != other.arena; }
+
+    scratch_arena *arena;
+};
+
+template<typename T>
+using scratch_vector = std::vector<T, scratch_allocator<T> >;
+
+} // libff
+
+#endif // SCRATCH_ARENA_HPP_
@@ -0,0 +1,79 @@
+/** @file
+ *****************************************************************************
+
+ Implementation of the task scheduler.
+
+ See task_scheduler.hpp .
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#include <algorithm>
+
+#include <libff/common/task_scheduler.hpp>
+
+namespace libff {
+
+task_scheduler::task_scheduler(const size_t num_workers) : next_sequence(0), stopping(false)
+{
+    const size_t count = (num_workers != 0 ? num_workers :
+                          std::max<size_t>(2, std::thread::hardware_concurrency()));
+    this->workers.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        this->workers.emplace_back(&task_scheduler::worker_loop, this);
+    }
+}
+
+task_scheduler::~task_scheduler()
+{
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->stopping = true;
+    }
+    this->has_work.notify_all();
+
+    for (std::thread &w : this->workers)
+    {
+        w.join();
+    }
+}
+
+task_scheduler& task_scheduler::global()
+{
+    static task_scheduler scheduler;
+    return scheduler;
+}
+
+void task_scheduler::enqueue(std::function<void()> run, const task_priority priority)
+{
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->queue.push(task{priority, this->next_sequence++, std::move(run)});
+    }
+    this->has_work.notify_one();
+}
+
+void task_scheduler::worker_loop()
+{
+    while (true)
+    {
+        std::function<void()> run;
+        {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            this->has_work.wait(lock, [this]() { return this->stopping || !this->queue.empty(); });
+            if (this->queue.empty())
+            {
+                return; // stopping, and nothing left to run
+            }
+            run = std::move(const_cast<task&>(this->queue.top()).run);
+            this->queue.pop();
+        }
+        run();
+    }
+}
+
+} // libff
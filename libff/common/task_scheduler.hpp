@@ -0,0 +1,95 @@
+/** @file
+ *****************************************************************************
+
+ Declaration of the task scheduler behind the asynchronous (*_async) variants
+ of the multi-exponentiation and pairing routines.
+
+ A fixed pool of worker threads takes tasks from a queue ordered by priority
+ and then by submission. Independent stages of a prover (e.g., the G1 and G2
+ multi-exponentiations and an FFT on the calling thread) can thus overlap.
+ Under MULTICORE each running task opens OpenMP parallel regions of its
+ own, so several tasks running at once share the cores; size
+ OMP_NUM_THREADS accordingly.
+
+ Tasks must not wait on futures of tasks that are queued after them, or the
+ pool may run out of workers.
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef TASK_SCHEDULER_HPP_
+#define TASK_SCHEDULER_HPP_
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace libff {
+
+enum task_priority {
+    task_priority_low,
+    task_priority_normal,
+    /* e.g., stages on the critical path of a pipeline */
+    task_priority_high
+};
+
+class task_scheduler {
+public:
+    /* num_workers = 0 means one worker per hardware thread (at least two) */
+    explicit task_scheduler(const size_t num_workers = 0);
+    /* Runs the tasks still queued, then joins the workers. */
+    ~task_scheduler();
+    task_scheduler(const task_scheduler &other) = delete;
+    task_scheduler& operator=(const task_scheduler &other) = delete;
+
+    /* The scheduler used by the *_async functions. */
+    static task_scheduler& global();
+
+    /**
+     * Queues f() and returns a future for its result; exceptions thrown by
+     * f are rethrown by the future's get().
+     */
+    template<typename F>
+    std::future<typename std::result_of<F()>::type> submit(F f, const task_priority priority = task_priority_normal);
+
+    size_t num_workers() const { return this->workers.size(); }
+
+private:
+    struct task {
+        task_priority priority;
+        uint64_t sequence;
+        std::function<void()> run;
+
+        /* the greatest element is dequeued first: highest priority, then oldest */
+        bool operator<(const task &other) const
+        {
+            return (priority != other.priority ? priority < other.priority : sequence > other.sequence);
+        }
+    };
+
+    void enqueue(std::function<void()> run, const task_priority priority);
+    void worker_loop();
+
+    std::vector<std::thread> workers;
+    std::priority_queue<task> queue;
+    uint64_t next_sequence;
+    bool stopping;
+    std::mutex mutex;
+    std::condition_variable has_work;
+};
+
+} // libff
+
+#include <libff/common/task_scheduler.tcc>
+
+#endif // TASK_SCHEDULER_HPP_
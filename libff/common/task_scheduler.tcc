@@ -0,0 +1,36 @@
+/** @file
+ *****************************************************************************
+
+ Implementation of templatized parts of the task scheduler.
+
+ See task_scheduler.hpp .
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef TASK_SCHEDULER_TCC_
+#define TASK_SCHEDULER_TCC_
+
+#include <memory>
+
+namespace libff {
+
+template<typename F>
+std::future<typename std::result_of<F()>::type> task_scheduler::submit(F f, const task_priority priority)
+{
+    typedef typename std::result_of<F()>::type result_type;
+
+    /* std::function needs a copyable target, packaged_task is move-only */
+    std::shared_ptr<std::packaged_task<result_type()> > t =
+        std::make_shared<std::packaged_task<result_type()> >(std::move(f));
+    std::future<result_type> result = t->get_future();
+    this->enqueue([t]() { (*t)(); }, priority);
+    return result;
+}
+
+} // libff
+
+#endif // TASK_SCHEDULER_TCC_
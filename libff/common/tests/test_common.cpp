@@ -0,0 +1,153 @@
+/**
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <string>
+#include <thread>
+
+#include <libff/algebra/curves/alt_bn128/alt_bn128_pp.hpp>
+#include <libff/algebra/scalar_multiplication/multiexp_async.hpp>
+#include <libff/common/assert.hpp>
+#include <libff/common/profiling.hpp>
+#include <libff/common/scratch_arena.hpp>
+#include <libff/common/utils.hpp>
+
+using namespace libff;
+
+void test_async_multi_exp_first()
+{
+    /*
+      the first scratch memory of the process is drawn by a worker of
+      task_scheduler::global(), after the scheduler was constructed; the
+      worker's arena is destroyed when the scheduler joins it at exit
+    */
+    alt_bn128_pp::init_public_params();
+    const size_t n = 16;
+    std::vector<alt_bn128_G1> bases(n, alt_bn128_G1::one());
+    std::vector<alt_bn128_Fr> scalars(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        bases[i] = (i == 0 ? bases[i] : bases[i-1] + bases[i-1]);
+        scalars[i] = alt_bn128_Fr::random_element();
+    }
+
+    std::future<alt_bn128_G1> msm = multi_exp_async<alt_bn128_G1, alt_bn128_Fr, multi_exp_method_BDLO12>(
+        bases.cbegin(), bases.cend(), scalars.cbegin(), scalars.cend(), 1);
+    const alt_bn128_G1 result = msm.get();
+
+    alt_bn128_G1 expected = alt_bn128_G1::zero();
+    for (size_t i = 0; i < n; ++i)
+    {
+        expected = expected + scalars[i] * bases[i];
+    }
+    ASSERT(result == expected);
+}
+
+struct alignas(256) scratch_test_block {
+    unsigned char bytes[256];
+};
+
+void test_scratch_arena()
+{
+    const size_t chunk_size = scratch_arena::min_chunk_size;
+    scratch_arena &arena = scratch_arena::thread_arena();
+    arena.release();
+
+    {
+        const scratch_scope outer;
+        scratch_vector<char> a(chunk_size / 2);
+        const size_t used_outer = arena.used();
+        {
+            const scratch_scope inner;
+            /* neither fits in what is left of the first chunk */
+            scratch_vector<char> b(chunk_size);
+            scratch_vector<scratch_test_block> c(3 * chunk_size / sizeof(scratch_test_block));
+            ASSERT(reinterpret_cast<uintptr_t>(c.data()) % alignof(scratch_test_block) == 0);
+            ASSERT(arena.capacity() >= chunk_size / 2 + chunk_size + 3 * chunk_size);
+            std::fill(b.begin(), b.end(), 1);
+            std::fill(a.begin(), a.end(), 2);
+            ASSERT(b[chunk_size - 1] == 1 && a[0] == 2);
+        }
+        ASSERT(arena.used() == used_outer);
+
+        /* the memory after the mark is reused, and aligned */
+        const scratch_arena::mark m = arena.get_mark();
+        void *p = arena.allocate(1, 1);
+        void *q = arena.allocate(chunk_size, 4096);
+        ASSERT(reinterpret_cast<uintptr_t>(q) % 4096 == 0);
+        ASSERT(p != q);
+        arena.rewind(m);
+        ASSERT(arena.used() == used_outer);
+    }
+    ASSERT(arena.used() == 0);
+
+    /* several chunks become one of their total size */
+    const size_t capacity = arena.capacity();
+    ASSERT(capacity > 2 * chunk_size);
+    arena.reset();
+    ASSERT(arena.used() == 0);
+    const size_t merged = arena.capacity();
+    ASSERT(merged >= capacity);
+    /* only a single chunk can hold this without growing */
+    arena.allocate(capacity - 64, 64);
+    ASSERT(arena.capacity() == merged);
+    arena.rewind(scratch_arena::mark{ 0, 0 });
+    ASSERT(arena.used() == 0);
+
+    /* trimming gives back the chunks added since, but never ones in use */
+    {
+        const scratch_scope scope;
+        arena.allocate(2 * merged, 64);
+        ASSERT(arena.capacity() > merged);
+        arena.trim(merged);
+        ASSERT(arena.capacity() > merged);
+    }
+    arena.trim(merged);
+    ASSERT(arena.capacity() == merged);
+    arena.allocate(merged - 64, 64);
+    ASSERT(arena.capacity() == merged);
+    arena.rewind(scratch_arena::mark{ 0, 0 });
+
+    scratch_arena::reset_all();
+    ASSERT(arena.capacity() == merged);
+    scratch_arena::release_all();
+    ASSERT(arena.capacity() == 0);
+}
+
+void test_concurrent_blocks()
+{
+    /* overlapping blocks of the same name on two threads are timed separately */
+    const std::string block = "Concurrent block";
+    cumulative_times.erase(block);
+    std::thread outer([&block]() {
+        enter_block(block);
+        std::this_thread::sleep_for(std::chrono::milliseconds(60));
+        leave_block(block);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    std::thread inner([&block]() {
+        enter_block(block);
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        leave_block(block);
+    });
+    outer.join();
+    inner.join();
+
+    const long long total = cumulative_times[block];
+    ASSERT(total >= 80 * 1000000ll);
+    UNUSED(total);
+}
+
+int main(void)
+{
+    /* must stay the first user of scratch memory in this process */
+    test_async_multi_exp_first();
+    test_scratch_arena();
+    test_concurrent_blocks();
+}